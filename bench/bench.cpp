@@ -0,0 +1,927 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <malloc.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "json.h"
+#include "jsonValue.h"
+
+// atomic because decode_lines may allocate on several threads
+static std::atomic<size_t> alloc_count{0};
+
+static std::atomic<size_t> live_bytes{0}, peak_bytes{0};
+
+static void *counted(void *p)
+{
+	if (!p)
+		throw std::bad_alloc();
+	alloc_count.fetch_add(1, std::memory_order_relaxed);
+	size_t size = malloc_usable_size(p);
+	size_t live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+	if (live > peak_bytes.load(std::memory_order_relaxed))
+		peak_bytes.store(live, std::memory_order_relaxed);
+	return p;
+}
+
+static void release(void *p) noexcept
+{
+	if (p)
+		live_bytes.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+	free(p);
+}
+
+void *operator new(size_t size)
+{
+	return counted(malloc(size ? size : 1));
+}
+
+void *operator new(size_t size, std::align_val_t align)
+{
+	size_t alignment = static_cast<size_t>(align);
+	return counted(aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment));
+}
+
+void operator delete(void *p) noexcept { release(p); }
+void operator delete(void *p, size_t) noexcept { release(p); }
+void operator delete(void *p, std::align_val_t) noexcept { release(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { release(p); }
+
+static const char *filter = nullptr;
+
+template <typename F>
+static void run(const char *name, size_t bytes, int iterations, F f, size_t numbers = 0)
+{
+	if (filter && strstr(name, filter) == nullptr)
+		return;
+	f();
+	size_t allocs = alloc_count;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+		f();
+	auto end = std::chrono::steady_clock::now();
+	double us = std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+	double allocs_per_iter = double(alloc_count - allocs) / iterations;
+	printf("%-36s %12.3f us %12.0f allocs", name, us, allocs_per_iter);
+	if (bytes)
+		printf(" %10.1f MB/s", bytes / us);
+	if (numbers)
+		printf(" %8.2f M numbers/s", numbers / us);
+	printf("\n");
+}
+
+static std::string make_deep(int depth, int fanout)
+{
+	if (depth == 0)
+		return "{\"id\":12345,\"name\":\"event\",\"ok\":true}";
+	std::string s = "{\"level\":" + std::to_string(depth) + ",\"children\":[";
+	for (int i = 0; i < fanout; ++i) {
+		if (i > 0) s += ',';
+		s += make_deep(depth - 1, i == 0 ? fanout : 1);
+	}
+	s += "]}";
+	return s;
+}
+
+static std::string make_wide(int count)
+{
+	std::string s = "[";
+	for (int i = 0; i < count; ++i) {
+		if (i > 0) s += ',';
+		s += "{\"id\":" + std::to_string(i) + ",\"name\":\"user" + std::to_string(i) +
+			"\",\"active\":true,\"tags\":[\"a\",\"b\",\"c\"],\"score\":" + std::to_string(i * 0.5) + "}";
+	}
+	s += "]";
+	return s;
+}
+
+static void bench_parse_tree()
+{
+	std::string deep = make_deep(20, 2);
+	std::string wide = make_wide(20000);
+
+	run("parse deep (20 levels)", deep.size(), 2000, [&] {
+		UT::Json j;
+		j.decode(deep);
+	});
+	run("parse wide (20k records)", wide.size(), 20, [&] {
+		UT::Json j;
+		j.decode(wide);
+	});
+
+	UT::Json response;
+	response.decode(make_wide(50));
+	std::string out;
+	response.stringify(out);
+	run("stringify response (new string)", out.size(), 20000, [&] {
+		std::string s;
+		response.stringify(s);
+	});
+	run("stringify response (reused buffer)", out.size(), 20000, [&] {
+		response.stringify(out);
+	});
+}
+
+static void bench_traverse()
+{
+	std::string wide = make_wide(100000);
+	UT::Json doc;
+	doc.decode(wide);
+	double sum = 0;
+
+	run("traverse copy (100k records)", 0, 10, [&] {
+		for (size_t i = 0; i < doc.get_array_size(); ++i) {
+			UT::Json record = doc.get_array_element(i);
+			sum += record.get_object_value(record.find_object_index("score")).get_number();
+			sum += record.get_object_value(record.find_object_index("name")).get_string().size();
+		}
+	});
+	run("traverse view (100k records)", 0, 10, [&] {
+		for (UT::JsonView record : doc.view()) {
+			sum += record.get_object_value(record.find_object_index("score")).get_number();
+			sum += record.get_object_value(record.find_object_index("name")).get_string_view().size();
+		}
+	});
+	if (sum < 0)
+		printf("%f\n", sum);
+}
+
+static void bench_object_lookup(const char *build_name, const char *find_name, int size, int iterations)
+{
+	std::vector<std::string> keys;
+	for (int i = 0; i < size; ++i)
+		keys.push_back("config.option." + std::to_string(i));
+	UT::Json value;
+	value.set_number(1);
+	UT::Json object;
+	long long found = 0;
+
+	run(build_name, 0, iterations, [&] {
+		object.set_object();
+		for (const std::string &key : keys)
+			object.set_object_value(key, value);
+	});
+	run(find_name, 0, iterations, [&] {
+		for (const std::string &key : keys)
+			found += object.find_object_index(key);
+	});
+	if (found < 0)
+		printf("%lld\n", found);
+}
+
+static void bench_object()
+{
+	bench_object_lookup("object build (8 keys)", "object find (8 keys)", 8, 200000);
+	bench_object_lookup("object build (2000 keys)", "object find (2000 keys)", 2000, 200);
+}
+
+static void bench_build()
+{
+	UT::Json array;
+	double sum = 0;
+	run("build array (100k numbers)", 0, 20, [&] {
+		array.set_array();
+		for (int i = 0; i < 100000; ++i) {
+			UT::Json e;
+			e = static_cast<double>(i);
+			array.push_back_array_element(e);
+		}
+	});
+	run("read array (100k numbers)", 0, 20, [&] {
+		for (size_t i = 0; i < array.get_array_size(); ++i)
+			sum += array.get_array_element(i).get_number();
+	});
+	UT::Json records;
+	run("build records (10k objects)", 0, 20, [&] {
+		records.set_array();
+		for (int i = 0; i < 10000; ++i) {
+			UT::Json record, id, active, score;
+			record.set_object();
+			id = static_cast<double>(i);
+			active.set_boolean(i % 2 == 0);
+			score = i * 0.5;
+			record.set_object_value("id", id);
+			record.set_object_value("active", active);
+			record.set_object_value("score", score);
+			records.push_back_array_element(record);
+		}
+	});
+	run("build records (10k objects, moved)", 0, 20, [&] {
+		records.set_array();
+		for (int i = 0; i < 10000; ++i) {
+			UT::Json record, id, active, score;
+			record.set_object();
+			id = static_cast<double>(i);
+			active.set_boolean(i % 2 == 0);
+			score = i * 0.5;
+			record.set_object_value("id", std::move(id));
+			record.set_object_value("active", std::move(active));
+			record.set_object_value("score", std::move(score));
+			records.push_back_array_element(std::move(record));
+		}
+	});
+	auto response = [&](bool moved) {
+		UT::Json body, users;
+		users.set_array();
+		for (int i = 0; i < 1000; ++i) {
+			UT::Json user, name, address, city;
+			user.set_object();
+			address.set_object();
+			name = "user name number " + std::to_string(i);
+			city = std::string("a city with a long name");
+			if (moved) {
+				address.set_object_value("city", std::move(city));
+				user.set_object_value("name", std::move(name));
+				user.set_object_value("address", std::move(address));
+				users.push_back_array_element(std::move(user));
+			} else {
+				address.set_object_value("city", city);
+				user.set_object_value("name", name);
+				user.set_object_value("address", address);
+				users.push_back_array_element(user);
+			}
+		}
+		body.set_object();
+		if (moved)
+			body.set_object_value("users", std::move(users));
+		else
+			body.set_object_value("users", users);
+		return body.get_object_size();
+	};
+	run("build response (1k users, copied)", 0, 200, [&] { sum += response(false); });
+	run("build response (1k users, moved)", 0, 200, [&] { sum += response(true); });
+	if (sum < 0)
+		printf("%f\n", sum);
+}
+
+static std::string make_state(int count, bool reversed, int changed)
+{
+	std::string s = "{";
+	for (int n = 0; n < count; ++n) {
+		int i = reversed ? count - 1 - n : n;
+		if (n > 0) s += ',';
+		s += "\"node" + std::to_string(i) + "\":{\"id\":" + std::to_string(i) +
+			",\"state\":\"" + (i == changed ? "failed" : "running") + "\",\"load\":[1,2,3]}";
+	}
+	s += "}";
+	return s;
+}
+
+static void bench_equal()
+{
+	UT::Json state, same, reordered, changed;
+	state.decode(make_state(50000, false, -1));
+	same.decode(make_state(50000, false, -1));
+	reordered.decode(make_state(50000, true, -1));
+	changed.decode(make_state(50000, false, 49999));
+	int equal = 0;
+
+	run("equal (50k keys, same order)", 0, 20, [&] { equal += state == same; });
+	run("equal (50k keys, reordered)", 0, 20, [&] { equal += state == reordered; });
+	run("equal (50k keys, last differs)", 0, 20, [&] { equal += state == changed; });
+	if (equal < 0)
+		printf("%d\n", equal);
+}
+
+static void bench_arena()
+{
+	std::string wide = make_wide(100000);
+
+	run("parse+destroy heap (100k records)", wide.size(), 10, [&] {
+		UT::Json j;
+		j.decode(wide);
+	});
+	run("parse+destroy arena (100k records)", wide.size(), 10, [&] {
+		UT::Json j;
+		j.decode_arena(wide);
+	});
+	std::pmr::unsynchronized_pool_resource pool;
+	run("parse+destroy pool (100k records)", wide.size(), 10, [&] {
+		UT::Json j;
+		j.decode(wide, &pool);
+	});
+}
+
+static std::string make_accounts(int count)
+{
+	static const char *keys[] = {"account_id", "customer_name", "email_address", "phone_number",
+		"street_address", "postal_code", "country_code", "created_at", "updated_at", "last_login_at",
+		"subscription_plan", "billing_cycle", "payment_method", "account_balance", "credit_limit",
+		"is_verified", "is_active", "referral_code", "preferred_language", "time_zone"};
+	std::string s = "[";
+	for (int i = 0; i < count; ++i) {
+		s += i > 0 ? ",{" : "{";
+		for (int k = 0; k < 20; ++k) {
+			if (k > 0) s += ',';
+			s += '"';
+			s += keys[k];
+			s += "\":";
+			s += k % 3 == 0 ? std::to_string(i * 7 + k) : "\"v" + std::to_string(k) + "\"";
+		}
+		s += '}';
+	}
+	s += "]";
+	return s;
+}
+
+// counts the bytes a tree asks its resource for, without the chunk rounding of the upstream
+class CountingResource : public std::pmr::memory_resource {
+	public:
+		size_t requested = 0;
+
+	private:
+		std::pmr::monotonic_buffer_resource upstream_;
+
+		void *do_allocate(size_t bytes, size_t alignment) override
+		{
+			requested += bytes;
+			return upstream_.allocate(bytes, alignment);
+		}
+		void do_deallocate(void *, size_t, size_t) override {}
+		bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
+
+static void bench_intern()
+{
+	std::string accounts = make_accounts(50000);
+	for (bool intern : {false, true}) {
+		const char *name = intern ? "parse arena, interned keys (50k records)" : "parse arena, copied keys (50k records)";
+		run(name, accounts.size(), 10, [&] {
+			UT::Json j;
+			j.decode_arena(accounts, intern);
+		});
+		if (filter && strstr(name, filter) == nullptr)
+			continue;
+		CountingResource counting;
+		UT::json::Value v(&counting);
+		if (intern)
+			v.decode_interned(accounts);
+		else
+			v.decode(accounts);
+		printf("%-36s %12zu bytes in %10zu bytes out %6.2f\n", intern ? "  memory, interned keys" : "  memory, copied keys",
+			accounts.size(), counting.requested, double(counting.requested) / accounts.size());
+	}
+}
+
+static std::string make_strings(int count, bool escapes)
+{
+	std::string line = "2024-05-01T12:00:00Z INFO request handled method=GET path=/api/v1/items/42 status=200 "
+		"duration_ms=12 user_agent=Mozilla/5.0 (X11; Linux x86_64) remote_addr=10.0.0.1 bytes=5120";
+	std::string s = "[";
+	for (int i = 0; i < count; ++i) {
+		if (i > 0) s += ',';
+		s += '"';
+		for (size_t j = 0; j < line.size(); ++j) {
+			if (escapes && j % 40 == 39)
+				s += "\\n";
+			s += line[j];
+		}
+		s += '"';
+	}
+	s += "]";
+	return s;
+}
+
+static void bench_strings()
+{
+	std::string plain = make_strings(50000, false);
+	std::string escaped = make_strings(50000, true);
+
+	run("parse strings (plain)", plain.size(), 20, [&] {
+		UT::Json j;
+		j.decode(plain);
+	});
+	run("parse strings (escape every 40B)", escaped.size(), 20, [&] {
+		UT::Json j;
+		j.decode(escaped);
+	});
+
+	UT::Json plain_json, escaped_json;
+	plain_json.decode(plain);
+	escaped_json.decode(escaped);
+	std::string out;
+	run("stringify strings (plain)", plain.size(), 20, [&] {
+		plain_json.stringify(out);
+	});
+	run("stringify strings (escape every 40B)", escaped.size(), 20, [&] {
+		escaped_json.stringify(out);
+	});
+}
+
+// re-indents a minified document the way editors and loggers usually do, two spaces per level
+static std::string make_pretty(const std::string &minified)
+{
+	std::string s;
+	int depth = 0;
+	bool in_string = false;
+	for (size_t i = 0; i < minified.size(); ++i) {
+		char c = minified[i];
+		s += c;
+		if (in_string) {
+			if (c == '\\')
+				s += minified[++i];
+			else if (c == '"')
+				in_string = false;
+		} else {
+			switch (c) {
+			case '"': in_string = true; break;
+			case ':': s += ' '; break;
+			case '[': case '{': s += '\n' + std::string(2 * ++depth, ' '); break;
+			case ',': s += '\n' + std::string(2 * depth, ' '); break;
+			}
+		}
+		if (!in_string && i + 1 < minified.size() && (minified[i + 1] == ']' || minified[i + 1] == '}'))
+			s += '\n' + std::string(2 * --depth, ' ');
+	}
+	return s;
+}
+
+static void bench_pretty()
+{
+	std::string minified = make_wide(20000);
+	std::string pretty = make_pretty(minified);
+
+	run("parse minified", minified.size(), 20, [&] {
+		UT::Json j;
+		j.decode(minified);
+	});
+	run("parse pretty", pretty.size(), 20, [&] {
+		UT::Json j;
+		j.decode(pretty);
+	});
+}
+
+static std::string make_coordinates(int count)
+{
+	std::string s = "[";
+	char buf[64];
+	for (int i = 0; i < count; ++i) {
+		snprintf(buf, sizeof(buf), "%s[%.6f,%.6f]", i ? "," : "", -180 + 360.0 * (i * 7919LL % 100003) / 100003, -90 + 180.0 * (i * 104729LL % 99991) / 99991);
+		s += buf;
+	}
+	s += "]";
+	return s;
+}
+
+static std::string make_series(int count)
+{
+	std::string s = "[";
+	char buf[96];
+	for (int i = 0; i < count; ++i) {
+		snprintf(buf, sizeof(buf), "%s{\"t\":%d,\"v\":%.17g}", i ? "," : "", 1700000000 + 60 * i, 20 + 5 * std::sin(i * 0.01));
+		s += buf;
+	}
+	s += "]";
+	return s;
+}
+
+static void bench_numbers()
+{
+	std::string coordinates = make_coordinates(50000);
+	std::string series = make_series(50000);
+
+	run("parse coordinates", coordinates.size(), 20, [&] {
+		UT::Json j;
+		j.decode(coordinates);
+	}, 100000);
+	run("parse time series", series.size(), 20, [&] {
+		UT::Json j;
+		j.decode(series);
+	}, 100000);
+
+	UT::Json coordinates_json, series_json;
+	coordinates_json.decode(coordinates);
+	series_json.decode(series);
+	std::string out;
+	run("stringify coordinates", coordinates.size(), 20, [&] {
+		coordinates_json.stringify(out);
+	}, 100000);
+	run("stringify time series", series.size(), 20, [&] {
+		series_json.stringify(out);
+	}, 100000);
+}
+
+static long peak_rss_kb()
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+// peak RSS only grows, so the sink runs first and the string path shows the difference
+static void bench_sink()
+{
+	if (filter && strstr("stringify large", filter) == nullptr)
+		return;
+	// built element by element so that no input text raises the peak beforehand
+	UT::Json doc, line;
+	doc.set_array();
+	line.decode(make_strings(1, false));
+	line = line.get_array_element(0);
+	for (int i = 0; i < 400000; ++i)
+		doc.push_back_array_element(line);
+	int fd = open("/dev/null", O_WRONLY);
+
+	long before = peak_rss_kb();
+	run("stringify large (fd sink)", 0, 3, [&] {
+		doc.stringify([fd](std::string_view chunk) {
+			if (write(fd, chunk.data(), chunk.size()) < 0)
+				abort();
+		});
+	});
+	printf("  peak RSS growth %ld kB\n", peak_rss_kb() - before);
+
+	before = peak_rss_kb();
+	run("stringify large (string + write)", 0, 3, [&] {
+		std::string s;
+		doc.stringify(s);
+		if (write(fd, s.data(), s.size()) < 0)
+			abort();
+	});
+	printf("  peak RSS growth %ld kB\n", peak_rss_kb() - before);
+	close(fd);
+}
+
+// the document arrives in 16 KiB reads; latency is measured from the last read to the
+// finished tree, peak is the heap high-water mark above the chunk list
+static void bench_push()
+{
+	if (filter && strstr("push", filter) == nullptr)
+		return;
+	std::string wide = make_wide(20000);
+	std::vector<std::string> chunks;
+	for (size_t i = 0; i < wide.size(); i += 16384)
+		chunks.push_back(wide.substr(i, 16384));
+	wide = std::string();
+
+	auto report = [](const char *name, double latency, double total, size_t peak) {
+		printf("%-36s %12.3f us after last chunk %12.3f us total %10zu kB peak\n", name, latency, total, peak / 1024);
+	};
+	using clock = std::chrono::steady_clock;
+	for (int round = 0; round < 3; ++round) {
+		{
+			size_t base = live_bytes;
+			peak_bytes = live_bytes.load();
+			auto start = clock::now();
+			std::string body;
+			for (size_t i = 0; i + 1 < chunks.size(); ++i)
+				body += chunks[i];
+			auto last = clock::now();
+			body += chunks.back();
+			UT::Json j;
+			j.decode(body);
+			auto end = clock::now();
+			report("push: buffer then decode", std::chrono::duration<double, std::micro>(end - last).count(),
+				std::chrono::duration<double, std::micro>(end - start).count(), peak_bytes - base);
+		}
+		{
+			size_t base = live_bytes;
+			peak_bytes = live_bytes.load();
+			auto start = clock::now();
+			UT::JsonPushParser parser;
+			for (size_t i = 0; i + 1 < chunks.size(); ++i)
+				parser.feed(chunks[i]);
+			auto last = clock::now();
+			parser.feed(chunks.back());
+			UT::Json j;
+			parser.finish(j);
+			auto end = clock::now();
+			report("push: JsonPushParser", std::chrono::duration<double, std::micro>(end - last).count(),
+				std::chrono::duration<double, std::micro>(end - start).count(), peak_bytes - base);
+		}
+	}
+}
+
+static size_t count_values(UT::JsonView v)
+{
+	size_t n = 1;
+	if (v.get_type() == UT::json::type::Array) {
+		for (UT::JsonView e : v)
+			n += count_values(e);
+	} else if (v.get_type() == UT::json::type::Object) {
+		for (UT::JsonMember m : v.members())
+			n += count_values(m.value);
+	}
+	return n;
+}
+
+struct CountingHandler : UT::JsonHandler {
+	size_t values = 0;
+	double score = 0;
+	bool in_score = false;
+
+	void on_null() override { ++values; }
+	void on_bool(bool) override { ++values; }
+	void on_number(double d) override
+	{
+		++values;
+		if (in_score)
+			score += d;
+	}
+	void on_string(std::string_view) override { ++values; }
+	void on_end_array(size_t) override { ++values; }
+	void on_end_object(size_t) override { ++values; }
+	void on_key(std::string_view key) override { in_score = key == "score"; }
+};
+
+static void bench_reuse()
+{
+	const std::string message = "{\"id\":12345,\"method\":\"update\",\"params\":{\"user\":\"ann\","
+		"\"tags\":[\"a\",\"b\"],\"score\":1.5,\"note\":\"a note longer than sixteen bytes\"}}";
+	// 1000 iterations of 1000 messages
+	UT::Json j;
+	run("small messages: Json::decode", message.size() * 1000, 1000, [&] {
+		for (int i = 0; i < 1000; ++i)
+			j.decode(message);
+	});
+	UT::JsonParser parser;
+	run("small messages: JsonParser", message.size() * 1000, 1000, [&] {
+		for (int i = 0; i < 1000; ++i)
+			parser.decode(message, j);
+	});
+}
+
+static void bench_sax()
+{
+	std::string wide = make_wide(20000);
+	size_t values = 0;
+
+	run("count values: decode + walk", wide.size(), 20, [&] {
+		UT::Json j;
+		j.decode(wide);
+		values = count_values(j.view());
+	});
+	run("count values: SAX", wide.size(), 20, [&] {
+		CountingHandler handler;
+		UT::decode(wide, handler);
+		values = handler.values;
+	});
+	if (values == 0)
+		printf("no values\n");
+}
+
+// a request whose handler reads a few header fields and ignores the large payload
+static std::string make_request(int records)
+{
+	return "{\"method\":\"update\",\"id\":42,\"user\":{\"name\":\"alice\",\"role\":\"admin\"},\"payload\":" +
+		make_wide(records) + "}";
+}
+
+static void bench_lazy()
+{
+	std::string request = make_request(2000);
+	size_t found = 0;
+
+	run("read 3 fields: eager decode", request.size(), 200, [&] {
+		UT::Json j;
+		j.decode(request);
+		UT::JsonView v = j.view();
+		UT::JsonView user = v.get_object_value(v.find_object_index("user"));
+		found += v.get_object_value(v.find_object_index("method")).get_string_view().size() +
+			static_cast<size_t>(v.get_object_value(v.find_object_index("id")).get_number()) +
+			user.get_object_value(user.find_object_index("name")).get_string_view().size();
+	});
+	run("read 3 fields: lazy decode", request.size(), 200, [&] {
+		UT::Json j;
+		j.decode(request, UT::json::parse_mode::Lazy);
+		UT::JsonView v = j.view();
+		UT::JsonView user = v.get_object_value(v.find_object_index("user"));
+		found += v.get_object_value(v.find_object_index("method")).get_string_view().size() +
+			static_cast<size_t>(v.get_object_value(v.find_object_index("id")).get_number()) +
+			user.get_object_value(user.find_object_index("name")).get_string_view().size();
+	});
+	if (found == 0)
+		printf("no fields\n");
+}
+
+// messages packed back to back in one receive buffer, parsed one slice at a time
+static void bench_slice()
+{
+	std::string buffer;
+	std::vector<std::pair<size_t, size_t>> messages;
+	for (int i = 0; i < 1000; ++i) {
+		std::string message = make_wide(20);
+		messages.emplace_back(buffer.size(), message.size());
+		buffer += message;
+	}
+
+	run("parse slices: copy to string", buffer.size(), 20, [&] {
+		for (auto [offset, size] : messages) {
+			UT::Json j;
+			j.decode(std::string(buffer, offset, size));
+		}
+	});
+	run("parse slices: string_view", buffer.size(), 20, [&] {
+		for (auto [offset, size] : messages) {
+			UT::Json j;
+			j.decode(std::string_view(buffer).substr(offset, size));
+		}
+	});
+}
+
+static void bench_lines()
+{
+	std::string records = make_wide(100000), lines;
+	// one record per line
+	for (size_t i = 1; i + 1 < records.size(); ++i) {
+		if (records[i] == ',' && records[i - 1] == '}' && records[i + 1] == '{')
+			lines += '\n';
+		else
+			lines += records[i];
+	}
+	lines += '\n';
+	size_t docs = 0;
+
+	run("json lines: split + decode", lines.size(), 5, [&] {
+		size_t begin = 0, end;
+		while ((end = lines.find('\n', begin)) != std::string::npos) {
+			UT::Json j;
+			j.decode(lines.substr(begin, end - begin));
+			docs += j.get_object_size();
+			begin = end + 1;
+		}
+	});
+	run("json lines: decode_lines", lines.size(), 5, [&] {
+		UT::decode_lines(lines, [&](UT::Json &j) { docs += j.get_object_size(); },
+			[](size_t, const std::string &) { abort(); });
+	});
+	if (docs == 0)
+		printf("no documents\n");
+
+	if (filter && strstr("json lines threads", filter) == nullptr)
+		return;
+	std::string large;
+	large.reserve(lines.size() * 12);
+	for (int i = 0; i < 12; ++i)
+		large += lines;
+	for (unsigned threads : {1u, 2u, 4u, 8u}) {
+		std::string name = "json lines: " + std::to_string(threads) + " threads";
+		run(name.c_str(), large.size(), 1, [&] {
+			UT::decode_lines(large, [&](UT::Json &j) { docs += j.get_object_size(); },
+				[](size_t, const std::string &) { abort(); }, threads);
+		});
+	}
+}
+
+static void bench_parallel()
+{
+	if (filter && strstr("parse large array", filter) == nullptr)
+		return;
+	std::string wide = make_wide(1000000);
+	run("parse large array: decode", wide.size(), 1, [&] {
+		UT::Json j;
+		j.decode(wide);
+	});
+	for (unsigned threads : {1u, 2u, 4u, 8u}) {
+		std::string name = "parse large array: " + std::to_string(threads) + " threads";
+		run(name.c_str(), wide.size(), 1, [&] {
+			UT::Json j;
+			j.decode_parallel(wide, threads);
+		});
+	}
+}
+
+// records with the longer keys and short values of a typical API response
+static std::string make_events(int count)
+{
+	std::string s = "[";
+	for (int i = 0; i < count; ++i) {
+		if (i > 0) s += ',';
+		s += "{\"event_id\":" + std::to_string(i) + ",\"created_at\":\"2024-05-01T12:" + std::to_string(10 + i % 50) +
+			":00Z\",\"user_id\":" + std::to_string(i % 977) + ",\"event_type\":\"" + (i % 3 ? "click" : "page_view") +
+			"\",\"country\":\"DE\",\"is_mobile\":false,\"session_length\":" + std::to_string(i % 600) + "}";
+	}
+	s += "]";
+	return s;
+}
+
+// heap bytes held by the decoded tree for each byte of input
+static void bench_memory()
+{
+	if (filter && strstr("memory per input byte", filter) == nullptr)
+		return;
+	struct Corpus {
+		const char *name;
+		std::string content;
+	} corpora[] = {
+		{"records", make_wide(20000)},
+		{"events", make_events(20000)},
+		{"strings", make_strings(2000, false)},
+		{"coordinates", make_coordinates(50000)},
+		{"time series", make_series(50000)},
+		{"keyed state", make_state(20000, false, -1)},
+		{"deep", make_deep(20, 2)},
+	};
+	for (const Corpus &corpus : corpora) {
+		size_t before = live_bytes;
+		UT::Json j;
+		j.decode(corpus.content);
+		size_t tree = live_bytes - before;
+		printf("memory per input byte: %-12s %10zu bytes in %10zu bytes out %6.2f\n", corpus.name, corpus.content.size(),
+			tree, double(tree) / corpus.content.size());
+	}
+}
+
+// each variant runs once in a child process, so that its peak RSS is its own
+template <typename F>
+static void run_child(const char *name, size_t bytes, F f)
+{
+	if (filter && strstr(name, filter) == nullptr)
+		return;
+	fflush(stdout);
+	pid_t pid = fork();
+	if (pid == 0) {
+		auto start = std::chrono::steady_clock::now();
+		f();
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		printf("%-36s %12.1f ms %10.1f MB/s", name, ms, bytes / ms / 1000);
+		fflush(stdout);
+		_exit(0);
+	}
+	int status;
+	struct rusage usage;
+	wait4(pid, &status, 0, &usage);
+	printf("   peak RSS %ld MB\n", usage.ru_maxrss / 1024);
+}
+
+static void bench_file()
+{
+	if (filter && strstr("decode file", filter) == nullptr)
+		return;
+	const char *path = "/tmp/ut_json_bench.json";
+	size_t size = 0;
+	{
+		// written in pieces so that the parent's RSS stays small before the forks
+		std::string records = make_wide(10000);
+		records = records.substr(1, records.size() - 2);
+		FILE *f = fopen(path, "wb");
+		fputc('[', f);
+		for (int i = 0; i < 220; ++i) {
+			if (i > 0) fputc(',', f);
+			fwrite(records.data(), 1, records.size(), f);
+		}
+		fputc(']', f);
+		size = ftell(f);
+		fclose(f);
+	}
+
+	run_child("decode file: read into string", size, [&] {
+		std::string content;
+		FILE *f = fopen(path, "rb");
+		content.resize(size);
+		if (fread(&content[0], 1, size, f) != size)
+			abort();
+		fclose(f);
+		UT::Json j;
+		j.decode(content);
+	});
+	run_child("decode file: decode_file", size, [&] {
+		UT::Json j;
+		j.decode_file(path);
+	});
+	run_child("decode file: decode_file lazy", size, [&] {
+		UT::Json j;
+		j.decode_file(path, UT::json::parse_mode::Lazy);
+		if (j.view().get_array_element(0).get_object_size() != 5)
+			abort();
+	});
+	remove(path);
+}
+
+int main(int argc, char **argv)
+{
+	if (argc > 1)
+		filter = argv[1];
+	bench_parse_tree();
+	bench_traverse();
+	bench_object();
+	bench_build();
+	bench_equal();
+	bench_arena();
+	bench_intern();
+	bench_strings();
+	bench_pretty();
+	bench_numbers();
+	bench_sink();
+	bench_push();
+	bench_reuse();
+	bench_sax();
+	bench_lazy();
+	bench_slice();
+	bench_lines();
+	bench_parallel();
+	bench_memory();
+	bench_file();
+	return 0;
+}
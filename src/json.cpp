@@ -1,15 +1,22 @@
+#include <algorithm>
+#include <cstring>
 #include <exception>
 #include <memory>
+#include <new>
 #include <utility>
 
 #include "json.h"
+#include "jsonFile.h"
+#include "jsonParallel.h"
+#include "jsonParser.h"
+#include "jsonPushParser.h"
 #include "jsonValue.h"
 #include "jsonException.h"
 
 namespace UT
 {
 
-    void Json::decode(const std::string &content, std::string &status) noexcept
+    void Json::decode(std::string_view content, std::string &status) noexcept
     {
         try
         {
@@ -25,8 +32,71 @@ namespace UT
         }
     }
 
-    void Json::decode(const std::string &content)
+    void Json::decode(std::string_view content)
     {
+        if (arena)
+            decode_arena(content);
+        else
+            v->decode(content);
+    }
+
+    void Json::decode(std::string_view content, std::pmr::memory_resource *resource)
+    {
+        reset(json::Value(json::Value::allocator_type(resource)));
+        v->decode(content);
+    }
+
+    void Json::decode(std::string_view content, json::parse_mode mode)
+    {
+        if (mode == json::parse_mode::Lazy)
+        {
+            reset_arena(content.size());
+            char *text = static_cast<char *>(arena->allocate(content.size(), 1));
+            memcpy(text, content.data(), content.size());
+            v->decode_lazy(text, content.size());
+            return;
+        }
+        if (arena)
+            reset_arena(content.size());
+        v->decode(content);
+    }
+
+    void Json::decode_arena(std::string_view content, bool intern_keys)
+    {
+        reset_arena(content.size());
+        if (intern_keys)
+            v->decode_interned(content);
+        else
+            v->decode(content);
+    }
+
+    void Json::decode_parallel(std::string_view content, unsigned threads)
+    {
+        // the workers allocate from the heap, so the tree cannot live in an arena
+        if (arena)
+            reset(json::Value());
+        json::decode_parallel(*v, content, threads);
+    }
+
+    void Json::decode_file(const std::string &path)
+    {
+        decode_file(path, json::parse_mode::Default);
+    }
+
+    void Json::decode_file(const std::string &path, json::parse_mode mode)
+    {
+        auto source = std::make_unique<json::File>(path);
+        std::string_view content = source->content();
+        if (mode == json::parse_mode::Lazy)
+        {
+            // the lazy tree points into the file itself instead of a copy
+            reset_arena(0);
+            v->decode_lazy(content.data(), content.size());
+            file = std::move(source);
+            return;
+        }
+        if (arena)
+            reset_arena(content.size());
         v->decode(content);
     }
 
@@ -35,35 +105,101 @@ namespace UT
         v->stringify(content);
     }
 
-    Json::Json() noexcept : v(new json::Value) {}
-    Json::~Json() noexcept = default;
+    void Json::stringify_append(std::string &content) const noexcept
+    {
+        v->stringify_append(content);
+    }
+
+    void Json::stringify(const json::Sink &sink) const
+    {
+        v->stringify(sink);
+    }
+
+    void Json::stringify(std::ostream &out) const
+    {
+        v->stringify([&out](std::string_view chunk) {
+            out.write(chunk.data(), chunk.size());
+        });
+    }
+
+    static_assert(sizeof(json::Value) <= 24 && alignof(json::Value) <= 8, "json::Value must fit Json::node");
+
+    Json::Json() noexcept : v(new (node) json::Value) {}
 
-    Json::Json(const Json &rhs) noexcept
+    Json::~Json() noexcept
     {
-        v = std::make_unique<json::Value>(*(rhs.v));
+        clear();
     }
 
+    Json::Json(const Json &rhs) noexcept : v(new (node) json::Value(*rhs.v)) {}
+
     Json &Json::operator=(const Json &rhs) noexcept
     {
-        v = std::make_unique<json::Value>(*(rhs.v));
+        reset(json::Value(*rhs.v));
         return *this;
     }
 
     Json::Json(Json &&rhs) noexcept
     {
-        v = std::move(rhs.v);
+        take(rhs);
     }
 
     Json &Json::operator=(Json &&rhs) noexcept
     {
-        v = std::move(rhs.v);
+        if (this != &rhs)
+        {
+            clear();
+            take(rhs);
+        }
         return *this;
     }
 
     void Json::swap(Json &rhs) noexcept
     {
-        using std::swap;
-        swap(v, rhs.v);
+        Json tmp(std::move(rhs));
+        rhs = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    // Destroys the tree; v is left dangling until it is set again.
+    void Json::clear() noexcept
+    {
+        // the tree lives in the arena and is released with it, without visiting the nodes
+        if (arena)
+            arena.reset();
+        else
+            v->~Value();
+        file.reset();
+    }
+
+    void Json::reset(json::Value &&value) noexcept
+    {
+        clear();
+        v = new (node) json::Value(std::move(value));
+    }
+
+    void Json::reset_arena(size_t size)
+    {
+        auto buffer = std::make_unique<std::pmr::monotonic_buffer_resource>(size + 1);
+        void *p = buffer->allocate(sizeof(json::Value), alignof(json::Value));
+        json::Value *root = new (p) json::Value(json::Value::allocator_type(buffer.get()));
+        clear();
+        v = root;
+        arena = std::move(buffer);
+    }
+
+    // Moves rhs's tree into *this, which holds none, and leaves rhs null.
+    void Json::take(Json &rhs) noexcept
+    {
+        file = std::move(rhs.file);
+        if (rhs.arena)
+        {
+            v = rhs.v;
+            arena = std::move(rhs.arena);
+            rhs.v = new (rhs.node) json::Value;
+        }
+        else
+            v = new (node) json::Value(std::move(*rhs.v));
     }
 
     json::type Json::get_type() const noexcept
@@ -96,6 +232,11 @@ namespace UT
     }
 
     const std::string Json::get_string() const noexcept
+    {
+        const auto &str = v->get_string();
+        return std::string(str.data(), str.size());
+    }
+    std::string_view Json::get_string_view() const noexcept
     {
         return v->get_string();
     }
@@ -111,17 +252,21 @@ namespace UT
     Json Json::get_array_element(size_t index) const noexcept
     {
         Json ret;
-        ret.v = std::make_unique<json::Value>(v->get_array_element(index));
+        *ret.v = v->get_array_element(index);
         return ret;
     }
     void Json::set_array() noexcept
     {
-        v->set_array(std::vector<json::Value>{});
+        v->set_array(std::pmr::vector<json::Value>{});
     }
     void Json::push_back_array_element(const Json &val) noexcept
     {
         v->push_back_array_element(*val.v);
     }
+    void Json::push_back_array_element(Json &&val) noexcept
+    {
+        v->push_back_array_element(std::move(*val.v));
+    }
     void Json::pop_back_array_element() noexcept
     {
         v->pop_back_array_element();
@@ -130,6 +275,10 @@ namespace UT
     {
         v->insert_array_element(*val.v, index);
     }
+    void Json::insert_array_element(Json &&val, size_t index) noexcept
+    {
+        v->insert_array_element(std::move(*val.v), index);
+    }
     void Json::erase_array_element(size_t index, size_t count) noexcept
     {
         v->erase_array_element(index, count);
@@ -140,13 +289,13 @@ namespace UT
     }
     void Json::set_object() noexcept
     {
-        v->set_object(std::vector<std::pair<std::string, json::Value>>{});
+        v->set_object(json::Members{});
     }
     size_t Json::get_object_size() const noexcept
     {
         return v->get_object_size();
     }
-    const std::string &Json::get_object_key(size_t index) const noexcept
+    std::string_view Json::get_object_key(size_t index) const noexcept
     {
         return v->get_object_key(index);
     }
@@ -157,14 +306,18 @@ namespace UT
     Json Json::get_object_value(size_t index) const noexcept
     {
         Json ret;
-        ret.v = std::make_unique<json::Value>(v->get_object_value(index));
+        *ret.v = v->get_object_value(index);
         return ret;
     }
-    void Json::set_object_value(const std::string& key, const Json &val) noexcept
+    void Json::set_object_value(std::string_view key, const Json &val) noexcept
     {
         v->set_object_value(key, *val.v);
     }
-    long long Json::find_object_index(const std::string& key) const noexcept
+    void Json::set_object_value(std::string_view key, Json &&val) noexcept
+    {
+        v->set_object_value(key, std::move(*val.v));
+    }
+    long long Json::find_object_index(std::string_view key) const noexcept
     {
         return v->find_object_index(key);
     }
@@ -176,6 +329,10 @@ namespace UT
     {
         v->clear_object();
     }
+    JsonView Json::view() const noexcept
+    {
+        return JsonView(v);
+    }
     bool operator==(const Json &lhs, const Json &rhs) noexcept
     {
         return *lhs.v == *rhs.v;
@@ -188,6 +345,141 @@ namespace UT
     {
         lhs.swap(rhs);
     }
+
+    void decode(std::string_view content, JsonHandler &handler)
+    {
+        json::Parser<JsonHandler>(handler, content);
+    }
+
+    size_t decode_lines(std::string_view content, const std::function<void(Json &)> &on_document,
+                        const std::function<void(size_t offset, const std::string &error)> &on_error)
+    {
+        Json doc;
+        json::TreeBuilder builder(doc.v->get_allocator().resource());
+        json::Parser<json::TreeBuilder> parser(builder);
+        size_t count = 0;
+        const char *p = content.data(), *end = p + content.size();
+        while (true)
+        {
+            while (p != end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+                ++p;
+            if (p == end)
+                break;
+
+            const char *start = p;
+            try
+            {
+                p = parser.parse_value(p, end);
+            }
+            catch (const json::Exception &e)
+            {
+                builder.clear();
+                on_error(start - content.data(), e.what());
+                p = std::find(start, end, '\n');
+                continue;
+            }
+
+            *doc.v = std::move(builder.root());
+            builder.clear();
+            ++count;
+            on_document(doc);
+        }
+        return count;
+    }
+
+    JsonPushParser::JsonPushParser() : p(new json::PushParser) {}
+
+    JsonPushParser::~JsonPushParser() noexcept = default;
+
+    void JsonPushParser::feed(std::string_view chunk)
+    {
+        p->feed(chunk.data(), chunk.data() + chunk.size());
+    }
+
+    void JsonPushParser::finish(Json &result)
+    {
+        json::Value value;
+        p->finish(value);
+        result.reset(std::move(value));
+    }
+
+    JsonParser::JsonParser() : p(new json::Decoder) {}
+
+    JsonParser::~JsonParser() noexcept = default;
+
+    void JsonParser::decode(std::string_view content, Json &result)
+    {
+        decode(content, result, json::parse_mode::Default);
+    }
+
+    void JsonParser::decode(std::string_view content, Json &result, json::parse_mode mode)
+    {
+        // a lazy tree builds nothing up front, so there is nothing to keep
+        if (mode == json::parse_mode::Lazy)
+        {
+            result.decode(content, mode);
+            return;
+        }
+        if (result.arena)
+            result.reset_arena(content.size());
+        p->decode(content, *result.v);
+    }
+
+    json::type JsonView::get_type() const noexcept
+    {
+        if (v == nullptr)
+            return json::type::Null;
+
+        return v->get_type();
+    }
+    double JsonView::get_number() const noexcept
+    {
+        return v->get_number();
+    }
+    std::string JsonView::get_string() const noexcept
+    {
+        return std::string(v->get_string());
+    }
+    std::string_view JsonView::get_string_view() const noexcept
+    {
+        return v->get_string();
+    }
+    size_t JsonView::get_array_size() const noexcept
+    {
+        return v->get_array_size();
+    }
+    JsonView JsonView::get_array_element(size_t index) const noexcept
+    {
+        return JsonView(&v->get_array_element(index));
+    }
+    size_t JsonView::get_object_size() const noexcept
+    {
+        return v->get_object_size();
+    }
+    std::string_view JsonView::get_object_key(size_t index) const noexcept
+    {
+        return v->get_object_key(index);
+    }
+    size_t JsonView::get_object_key_length(size_t index) const noexcept
+    {
+        return v->get_object_key_length(index);
+    }
+    JsonView JsonView::get_object_value(size_t index) const noexcept
+    {
+        return JsonView(&v->get_object_value(index));
+    }
+    long long JsonView::find_object_index(std::string_view key) const noexcept
+    {
+        return v->find_object_index(key);
+    }
+    bool operator==(const JsonView &lhs, const JsonView &rhs) noexcept
+    {
+        return *lhs.v == *rhs.v;
+    }
+    bool operator!=(const JsonView &lhs, const JsonView &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
 }
 
 std::ostream &UT::json::operator<<(std::ostream &out, type t) noexcept
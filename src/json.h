@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <ostream>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 namespace UT
 {
@@ -21,15 +26,68 @@ namespace UT
 
         std::ostream& operator<<(std::ostream& out, type t) noexcept;
 
+        // Lazy validates the input, keeps a copy of it in the Json's arena and builds
+        // each array or object only when it is first accessed. That first access may be
+        // through a const accessor, view() or operator==, so unlike other trees a lazy
+        // Json is not safe to read from several threads without synchronization.
+        enum class parse_mode : int
+        {
+            Default,
+            Lazy
+        };
+
+        // receives the output of a streaming stringify, one chunk at a time
+        using Sink = std::function<void(std::string_view)>;
+
         class Value;
+        class PushParser;
+        class Decoder;
+        class File;
     }
 
+    class JsonView;
+    struct JsonMember;
+
+    // Events of decode(content, handler), in document order. Every member is preceded by
+    // on_key; the end events carry the number of elements or members. A handler may
+    // throw to stop early. String views are valid only during the call.
+    class JsonHandler
+    {
+    public:
+        virtual ~JsonHandler() = default;
+
+        virtual void on_null() {}
+        virtual void on_bool(bool) {}
+        virtual void on_number(double) {}
+        virtual void on_string(std::string_view) {}
+        virtual void on_start_array() {}
+        virtual void on_end_array(size_t) {}
+        virtual void on_start_object() {}
+        virtual void on_key(std::string_view) {}
+        virtual void on_end_object(size_t) {}
+    };
+
+    // Validates content and reports it to handler without building a tree. Errors are
+    // thrown as in Json::decode, possibly after some events were delivered.
+    void decode(std::string_view content, JsonHandler &handler);
+
     class Json final
     {
     public:
-        void decode(const std::string &content, std::string &status) noexcept;
-        void decode(const std::string &content);
+        void decode(std::string_view content, std::string &status) noexcept;
+        void decode(std::string_view content);
+        void decode(std::string_view content, std::pmr::memory_resource *resource);
+        void decode(std::string_view content, json::parse_mode mode);
+        // intern_keys stores each distinct object key once, e.g. for arrays of records
+        void decode_arena(std::string_view content, bool intern_keys = false);
+        // parses the elements of a root array on threads workers, 0 for one per core
+        void decode_parallel(std::string_view content, unsigned threads = 0);
+        void decode_file(const std::string &path);
+        void decode_file(const std::string &path, json::parse_mode mode);
         void stringify(std::string &content) const noexcept;
+        void stringify_append(std::string &content) const noexcept;
+        void stringify(const json::Sink &sink) const;
+        void stringify(std::ostream &out) const;
 
         Json() noexcept;
         ~Json() noexcept;
@@ -70,31 +128,54 @@ namespace UT
         void set_number(double d) noexcept;
 
         const std::string get_string() const noexcept;
+        std::string_view get_string_view() const noexcept;
         void set_string(const std::string &str) noexcept;
 
         size_t get_array_size() const noexcept;
         Json get_array_element(size_t index) const noexcept;
         void set_array() noexcept;
+        // the rvalue overloads take val's tree instead of copying it, unless the two trees
+        // use different memory resources (e.g. one was decoded into an arena)
         void push_back_array_element(const Json &val) noexcept;
+        void push_back_array_element(Json &&val) noexcept;
         void pop_back_array_element() noexcept;
         void insert_array_element(const Json &val, size_t index) noexcept;
+        void insert_array_element(Json &&val, size_t index) noexcept;
         void erase_array_element(size_t index, size_t count) noexcept;
         void clear_array() noexcept;
 
         void set_object() noexcept;
         size_t get_object_size() const noexcept;
-        const std::string &get_object_key(size_t index) const noexcept;
+        std::string_view get_object_key(size_t index) const noexcept;
         size_t get_object_key_length(size_t index) const noexcept;
 
         Json get_object_value(size_t index) const noexcept;
-        void set_object_value(const std::string& key, const Json &val) noexcept;
-        long long find_object_index(const std::string& key) const noexcept;
+        void set_object_value(std::string_view key, const Json &val) noexcept;
+        void set_object_value(std::string_view key, Json &&val) noexcept;
+        long long find_object_index(std::string_view key) const noexcept;
         void remove_object_value(size_t index) noexcept;
         void clear_object() noexcept;
 
+        JsonView view() const noexcept;
+
     private:
-        std::unique_ptr<json::Value> v;
+        void clear() noexcept;
+        void reset(json::Value &&value) noexcept;
+        void reset_arena(size_t size);
+        void take(Json &rhs) noexcept;
+
+        // The root lives in node, so a scalar costs no allocation; only the size of
+        // json::Value is fixed here. A tree decoded into an arena keeps its root there.
+        json::Value *v;
+        alignas(8) unsigned char node[24];
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
+        // the file a lazily decoded tree points into
+        std::unique_ptr<json::File> file;
 
+        friend class JsonPushParser;
+        friend class JsonParser;
+        friend size_t decode_lines(std::string_view content, const std::function<void(Json &)> &on_document,
+                                   const std::function<void(size_t offset, const std::string &error)> &on_error);
         friend bool operator==(const Json &lhs, const Json &rhs) noexcept;
         friend bool operator!=(const Json &lhs, const Json &rhs) noexcept;
     };
@@ -102,4 +183,165 @@ namespace UT
     bool operator==(const Json &lhs, const Json &rhs) noexcept;
     bool operator!=(const Json &lhs, const Json &rhs) noexcept;
     void swap(Json &lhs, Json &rhs) noexcept;
+
+    // Decodes every document in content, e.g. JSON Lines; documents are separated by
+    // whitespace or simply follow each other. A document that fails to parse is reported
+    // to on_error with its offset, and decoding resumes on the next line. on_document may
+    // move the Json away. Returns the number of documents decoded.
+    size_t decode_lines(std::string_view content, const std::function<void(Json &)> &on_document,
+                        const std::function<void(size_t offset, const std::string &error)> &on_error);
+
+    // The same on threads workers. content is split at newlines, so a document must not
+    // span lines. If ordered, the callbacks run on the calling thread in input order;
+    // otherwise the workers call them as documents finish, and they must be thread-safe.
+    size_t decode_lines(std::string_view content, const std::function<void(Json &)> &on_document,
+                        const std::function<void(size_t offset, const std::string &error)> &on_error,
+                        unsigned threads, bool ordered = true);
+
+    // Parses a document that arrives in pieces, e.g. an HTTP body read from a socket.
+    // feed() consumes the whole piece; only an unfinished token is kept between calls.
+    // After an exception the parser starts over with the next feed().
+    class JsonPushParser final
+    {
+    public:
+        JsonPushParser();
+        ~JsonPushParser() noexcept;
+
+        void feed(std::string_view chunk);
+        void finish(Json &result);
+
+    private:
+        std::unique_ptr<json::PushParser> p;
+    };
+
+    // Decodes many documents one after another, e.g. one per request in a server loop.
+    // The parser keeps its scratch buffers and stacks between calls, so once they have
+    // grown to fit the messages only the resulting tree is allocated. Use one per thread.
+    class JsonParser final
+    {
+    public:
+        JsonParser();
+        ~JsonParser() noexcept;
+
+        // the same as result.decode(content, mode)
+        void decode(std::string_view content, Json &result);
+        void decode(std::string_view content, Json &result, json::parse_mode mode);
+
+    private:
+        std::unique_ptr<json::Decoder> p;
+    };
+
+    class JsonView final
+    {
+    public:
+        class ArrayIterator;
+        class ObjectIterator;
+        class Members;
+
+        JsonView() noexcept = default;
+
+        json::type get_type() const noexcept;
+        double get_number() const noexcept;
+        // a copy that outlives the document; get_string_view() does not copy
+        std::string get_string() const noexcept;
+        std::string_view get_string_view() const noexcept;
+
+        size_t get_array_size() const noexcept;
+        JsonView get_array_element(size_t index) const noexcept;
+
+        size_t get_object_size() const noexcept;
+        std::string_view get_object_key(size_t index) const noexcept;
+        size_t get_object_key_length(size_t index) const noexcept;
+        JsonView get_object_value(size_t index) const noexcept;
+        long long find_object_index(std::string_view key) const noexcept;
+
+        ArrayIterator begin() const noexcept;
+        ArrayIterator end() const noexcept;
+        Members members() const noexcept;
+
+    private:
+        explicit JsonView(const json::Value *v) noexcept : v(v) {}
+
+        const json::Value *v = nullptr;
+
+        friend class Json;
+        friend bool operator==(const JsonView &lhs, const JsonView &rhs) noexcept;
+    };
+
+    bool operator==(const JsonView &lhs, const JsonView &rhs) noexcept;
+    bool operator!=(const JsonView &lhs, const JsonView &rhs) noexcept;
+
+    struct JsonMember
+    {
+        std::string_view key;
+        JsonView value;
+    };
+
+    class JsonView::ArrayIterator final
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = JsonView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = JsonView;
+
+        ArrayIterator(JsonView parent, size_t index) noexcept : parent(parent), index(index) {}
+
+        JsonView operator*() const noexcept { return parent.get_array_element(index); }
+        ArrayIterator &operator++() noexcept
+        {
+            ++index;
+            return *this;
+        }
+        ArrayIterator operator++(int) noexcept { return ArrayIterator(parent, index++); }
+        bool operator==(const ArrayIterator &rhs) const noexcept { return index == rhs.index; }
+        bool operator!=(const ArrayIterator &rhs) const noexcept { return index != rhs.index; }
+
+    private:
+        JsonView parent;
+        size_t index;
+    };
+
+    class JsonView::ObjectIterator final
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = JsonMember;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = JsonMember;
+
+        ObjectIterator(JsonView parent, size_t index) noexcept : parent(parent), index(index) {}
+
+        JsonMember operator*() const noexcept { return JsonMember{parent.get_object_key(index), parent.get_object_value(index)}; }
+        ObjectIterator &operator++() noexcept
+        {
+            ++index;
+            return *this;
+        }
+        ObjectIterator operator++(int) noexcept { return ObjectIterator(parent, index++); }
+        bool operator==(const ObjectIterator &rhs) const noexcept { return index == rhs.index; }
+        bool operator!=(const ObjectIterator &rhs) const noexcept { return index != rhs.index; }
+
+    private:
+        JsonView parent;
+        size_t index;
+    };
+
+    class JsonView::Members final
+    {
+    public:
+        explicit Members(JsonView parent) noexcept : parent(parent) {}
+
+        ObjectIterator begin() const noexcept { return ObjectIterator(parent, 0); }
+        ObjectIterator end() const noexcept { return ObjectIterator(parent, parent.get_object_size()); }
+
+    private:
+        JsonView parent;
+    };
+
+    inline JsonView::ArrayIterator JsonView::begin() const noexcept { return ArrayIterator(*this, 0); }
+    inline JsonView::ArrayIterator JsonView::end() const noexcept { return ArrayIterator(*this, get_array_size()); }
+    inline JsonView::Members JsonView::members() const noexcept { return Members(*this); }
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include <cstdio>
+
+#include "jsonException.h"
+#include "jsonFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UT_JSON_MMAP
+#endif
+
+namespace UT::json
+    {
+        File::File(const std::string &path)
+        {
+#ifdef UT_JSON_MMAP
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw(Exception("file cannot open"));
+            struct stat st;
+            if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+            {
+                void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED)
+                {
+                    madvise(p, st.st_size, MADV_SEQUENTIAL);
+                    data_ = static_cast<const char *>(p);
+                    size_ = st.st_size;
+                    mapped_ = true;
+                    close(fd);
+                    return;
+                }
+            }
+            if (fstat(fd, &st) == 0 && st.st_size > 0)
+                buffer_.reserve(st.st_size);
+            char chunk[64 * 1024];
+            ssize_t n;
+            while ((n = read(fd, chunk, sizeof(chunk))) > 0)
+                buffer_.append(chunk, n);
+            close(fd);
+            if (n < 0)
+                throw(Exception("file cannot read"));
+#else
+            std::FILE *f = std::fopen(path.c_str(), "rb");
+            if (!f)
+                throw(Exception("file cannot open"));
+            char chunk[64 * 1024];
+            size_t n;
+            while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0)
+                buffer_.append(chunk, n);
+            bool failed = std::ferror(f);
+            std::fclose(f);
+            if (failed)
+                throw(Exception("file cannot read"));
+#endif
+            data_ = buffer_.c_str();
+            size_ = buffer_.size();
+        }
+
+        File::~File() noexcept
+        {
+#ifdef UT_JSON_MMAP
+            if (mapped_)
+                munmap(const_cast<char *>(data_), size_);
+#endif
+        }
+    }
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace UT::json {
+        // The contents of a file: mapped when it is a non-empty regular file, read into a
+        // string otherwise.
+        class File final {
+            public:
+                explicit File(const std::string& path);
+                ~File() noexcept;
+
+                File(const File&) = delete;
+                File& operator=(const File&) = delete;
+
+                std::string_view content() const noexcept { return {data_, size_}; }
+
+            private:
+                const char* data_ = nullptr;
+                size_t size_ = 0;
+                bool mapped_ = false;
+                std::string buffer_;
+        };
+    }
@@ -1,26 +1,84 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
 #include "jsonGenerator.h"
+#include "jsonSimd.h"
 
 namespace UT {
     namespace json {
         Generator::Generator(const Value &val, std::string &result): res_(result)
         {
+            // grow geometrically, so that many stringify_append calls into one buffer stay
+            // linear where reserve allocates exactly the size asked for
+            size_t needed = res_.size() + estimate(val);
+            if (needed > res_.capacity())
+                res_.reserve(std::max(needed, 2 * res_.capacity()));
+            stringify_value(val);
+        }
+
+        Generator::Generator(const Value &val, std::string &buffer, const Sink &sink): res_(buffer), sink_(&sink)
+        {
+            res_.clear();
+            res_.reserve(chunk_size + chunk_size / 4);
+            stringify_value(val);
+            flush();
+        }
+
+        void Generator::flush()
+        {
+            if (!res_.empty())
+                (*sink_)(res_);
             res_.clear();
-            stringify_value(val);  
+        }
+
+        // Exact except for escapes, which are rare, and fractional numbers, which are
+        // counted at their longest.
+        size_t Generator::estimate(const Value &v) noexcept
+        {
+            switch (v.get_type())
+            {
+                case type::Null:
+                case type::True: return 4;
+                case type::False: return 5;
+                case type::Number: {
+                    double d = v.get_number();
+                    if (!(d >= -9007199254740992.0 && d <= 9007199254740992.0 && d == static_cast<long long>(d)))
+                        return 24;
+                    size_t n = std::signbit(d) ? 2 : 1;
+                    for (long long i = static_cast<long long>(d); i >= 10 || i <= -10; i /= 10)
+                        ++n;
+                    return n;
+                }
+                case type::String: return v.get_string().size() + 2;
+                case type::Array: {
+                    size_t n = v.get_array_size();
+                    size_t size = n > 0 ? n + 1 : 2;
+                    for (size_t i = 0; i < n; ++i)
+                        size += estimate(v.get_array_element(i));
+                    return size;
+                }
+                case type::Object: {
+                    size_t n = v.get_object_size();
+                    size_t size = n > 0 ? 2 * n + 1 : 2;
+                    for (size_t i = 0; i < n; ++i)
+                        size += v.get_object_key_length(i) + 2 + estimate(v.get_object_value(i));
+                    return size;
+                }
+            }
+            return 0;
         }
 
         void Generator::stringify_value(const Value &v)
         {
+            if (sink_ && res_.size() >= chunk_size)
+                flush();
             switch (v.get_type())
             {
                 case type::Null: res_ += "null"; break;
                 case type::True: res_ += "true"; break;
                 case type::False: res_ += "false"; break;
-                case type::Number: {
-                    char buffer[32] = {0};
-                    sprintf(buffer, "%.17g", v.get_number());
-                    res_ += buffer;
-                }
-                break;
+                case type::Number: stringify_number(v.get_number()); break;
                 case type::String: stringify_string(v.get_string()); break;
                 case type::Array: 
                     res_ += '[';
@@ -43,31 +101,45 @@ namespace UT {
             }
         }
 
-        void Generator::stringify_string(const std::string &str)
+        void Generator::stringify_number(double d)
+        {
+            // shortest text that reads back as the same double; whole numbers below 2^53 are
+            // printed as integers, where to_chars would prefer 1e+05 to 100000
+            char buffer[32];
+            char *end;
+            if (d >= -9007199254740992.0 && d <= 9007199254740992.0 && d == static_cast<long long>(d) && !(d == 0 && std::signbit(d)))
+                end = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<long long>(d)).ptr;
+            else
+                end = std::to_chars(buffer, buffer + sizeof(buffer), d).ptr;
+            res_.append(buffer, end);
+        }
+
+        void Generator::stringify_string(std::string_view str)
         {
+            // the escape letter of each control character; 'u' is written as \u00XX
+            static const char control_escape[] = "uuuuuuuubtnufruuuuuuuuuuuuuuuuuu";
+            static const char hex[] = "0123456789ABCDEF";
+
             res_ += '\"';
-            for(auto it = str.begin(); it != str.end(); ++it) {
-                unsigned char ch = *it;
-                switch (ch)
-                {
-                    case '\"': res_ += "\\\""; break;
-                    case '\\': res_ += "\\\\"; break;
-                    case '\b': res_ += "\\b"; break;
-                    case '\f': res_ += "\\f"; break;
-                    case '\n': res_ += "\\n"; break;
-                    case '\r': res_ += "\\r"; break; 
-                    case '\t': res_ += "\\t"; break; 
+            const char *p = str.data(), *end = p + str.size();
+            while (true)
+            {
+                const char *q = simd::scan_string(p, end);
+                res_.append(p, q);
+                if (q == end)
+                    break;
 
-                    default: 
-                        if(ch < 0x20) {
-                            char buffer[7] = {0};
-                            sprintf(buffer, "\\u%04X", ch);
-                            res_ += buffer;
-                        } else
-                            res_ += *it;
+                unsigned char ch = *q;
+                char e = ch < 0x20 ? control_escape[ch] : ch;
+                res_ += '\\';
+                res_ += e;
+                if (e == 'u')
+                {
+                    const char code[] = {'0', '0', hex[ch >> 4], hex[ch & 0xF]};
+                    res_.append(code, sizeof(code));
                 }
+                p = q + 1;
             }
-
             res_ += '\"';
         }
     }
@@ -1,15 +1,28 @@
 #pragma once
 
+#include <cstddef>
+#include <string>
+#include <string_view>
+
 #include "jsonValue.h"
 
 namespace UT::json {
         class Generator final {
             public:
+                // appends to result
                 Generator(const Value& val, std::string& result);
+                // hands the text to sink in pieces of about chunk_size bytes, using buffer as scratch
+                Generator(const Value& val, std::string& buffer, const Sink& sink);
+
+                static constexpr size_t chunk_size = 64 * 1024;
             private:
+                static size_t estimate(const Value &v) noexcept;
+                void flush();
                 void stringify_value(const Value &v);
-                void stringify_string(const std::string &str);
+                void stringify_number(double d);
+                void stringify_string(std::string_view str);
 
-                std::string& res_; 
+                std::string& res_;
+                const Sink* sink_ = nullptr;
         };
     }
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "json.h"
+
+namespace UT
+{
+    namespace
+    {
+        struct Error
+        {
+            size_t before; // documents of the chunk that precede the error
+            size_t offset;
+            std::string message;
+        };
+
+        struct Chunk
+        {
+            const char *begin;
+            const char *end;
+            bool done = false;
+            std::vector<Json> documents;
+            std::vector<Error> errors;
+        };
+
+        // large enough that a chunk holds many lines, small enough to keep the workers busy
+        const size_t chunk_size = 1024 * 1024;
+    }
+
+    size_t decode_lines(std::string_view content, const std::function<void(Json &)> &on_document,
+                        const std::function<void(size_t offset, const std::string &error)> &on_error,
+                        unsigned threads, bool ordered)
+    {
+        if (threads <= 1 || content.size() <= chunk_size)
+            return decode_lines(content, on_document, on_error);
+
+        // chunks end after a newline, so that no line is split between two of them
+        std::vector<Chunk> chunks;
+        const char *p = content.data(), *end = p + content.size();
+        while (p != end)
+        {
+            const char *q = p + std::min<size_t>(chunk_size, end - p);
+            q = std::find(q, end, '\n');
+            if (q != end)
+                ++q;
+            chunks.push_back({p, q, false, {}, {}});
+            p = q;
+        }
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        size_t next = 0, delivered = 0, count = 0;
+        // in input order at most this many chunks are decoded ahead of the caller
+        const size_t window = 2 * size_t(threads);
+        bool stop = false;
+        std::exception_ptr failure;
+
+        auto work = [&] {
+            while (true)
+            {
+                size_t i;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&] { return stop || next == chunks.size() || !ordered || next < delivered + window; });
+                    if (stop || next == chunks.size())
+                        return;
+                    i = next++;
+                }
+
+                Chunk &chunk = chunks[i];
+                size_t base = chunk.begin - content.data();
+                size_t n = 0;
+                try
+                {
+                    std::string_view text(chunk.begin, chunk.end - chunk.begin);
+                    if (ordered)
+                        n = decode_lines(text, [&](Json &doc) { chunk.documents.push_back(std::move(doc)); },
+                                         [&](size_t offset, const std::string &error) {
+                                             chunk.errors.push_back({chunk.documents.size(), base + offset, error});
+                                         });
+                    else
+                        n = decode_lines(text, on_document, [&](size_t offset, const std::string &error) {
+                            on_error(base + offset, error);
+                        });
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!failure)
+                        failure = std::current_exception();
+                    stop = true;
+                    changed.notify_all();
+                    return;
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                chunk.done = true;
+                count += n;
+                changed.notify_all();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i)
+            workers.emplace_back(work);
+
+        try
+        {
+            // the callbacks run here, in input order, while the workers decode ahead
+            for (size_t i = 0; ordered && i < chunks.size(); ++i)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&] { return stop || chunks[i].done; });
+                    if (stop)
+                        break;
+                }
+                Chunk &chunk = chunks[i];
+                size_t d = 0;
+                for (Error &error : chunk.errors)
+                {
+                    for (; d < error.before; ++d)
+                        on_document(chunk.documents[d]);
+                    on_error(error.offset, error.message);
+                }
+                for (; d < chunk.documents.size(); ++d)
+                    on_document(chunk.documents[d]);
+                std::vector<Json>().swap(chunk.documents);
+                std::vector<Error>().swap(chunk.errors);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                delivered = i + 1;
+                changed.notify_all();
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!failure)
+                failure = std::current_exception();
+            stop = true;
+            changed.notify_all();
+        }
+
+        for (std::thread &worker : workers)
+            worker.join();
+        if (failure)
+            std::rethrow_exception(failure);
+        return count;
+    }
+}
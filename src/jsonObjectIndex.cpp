@@ -0,0 +1,57 @@
+#include <functional>
+
+#include "jsonObjectIndex.h"
+#include "jsonValue.h"
+
+namespace UT::json
+    {
+        ObjectIndex::ObjectIndex(const Member *members, size_t size, std::pmr::memory_resource *resource) : slots_(resource)
+        {
+            rehash(members, size);
+        }
+
+        long long ObjectIndex::find(const Member *members, std::string_view key) const noexcept
+        {
+            size_t mask = slots_.size() - 1;
+            for (size_t i = std::hash<std::string_view>{}(key) & mask; slots_[i] != 0; i = (i + 1) & mask)
+            {
+                if (members[slots_[i] - 1].key.view() == key)
+                    return slots_[i] - 1;
+            }
+            return -1;
+        }
+
+        void ObjectIndex::insert(const Member *members, size_t size, size_t index)
+        {
+            if ((count_ + 1) * 2 > slots_.size())
+                rehash(members, size);
+            else
+                place(members, index);
+        }
+
+        void ObjectIndex::rehash(const Member *members, size_t size)
+        {
+            size_t slots = 16;
+            while (slots < size * 2)
+                slots <<= 1;
+            slots_.assign(slots, 0);
+            count_ = 0;
+            for (size_t i = 0; i < size; ++i)
+                place(members, i);
+        }
+
+        bool ObjectIndex::place(const Member *members, size_t index) noexcept
+        {
+            size_t mask = slots_.size() - 1;
+            std::string_view key = members[index].key.view();
+            size_t i = std::hash<std::string_view>{}(key) & mask;
+            for (; slots_[i] != 0; i = (i + 1) & mask)
+            {
+                if (members[slots_[i] - 1].key.view() == key)
+                    return false;
+            }
+            slots_[i] = static_cast<uint32_t>(index + 1);
+            ++count_;
+            return true;
+        }
+    }
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace UT::json {
+        class Value;
+        struct Member;
+
+        // how members are handed to Value::set_object
+        using Members = std::pmr::vector<std::pair<std::pmr::string, Value>>;
+
+        class ObjectIndex final {
+            public:
+                static constexpr size_t threshold = 16;
+
+                ObjectIndex(const Member* members, size_t size, std::pmr::memory_resource* resource);
+
+                long long find(const Member* members, std::string_view key) const noexcept;
+                void insert(const Member* members, size_t size, size_t index);
+
+            private:
+                void rehash(const Member* members, size_t size);
+                bool place(const Member* members, size_t index) noexcept;
+
+                std::pmr::vector<uint32_t> slots_;
+                size_t count_ = 0;
+        };
+    }
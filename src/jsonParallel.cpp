@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "jsonException.h"
+#include "jsonParallel.h"
+#include "jsonParser.h"
+#include "jsonStructuralIndex.h"
+
+namespace UT::json
+    {
+        static const char *skip_whitespace(const char *p, const char *end) noexcept
+        {
+            while (p != end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+                ++p;
+            return p;
+        }
+
+        // Parses the elements between two split points: values separated by commas.
+        static void parse_elements(Parser<TreeBuilder> &parser, const char *p, const char *end)
+        {
+            p = skip_whitespace(p, end);
+            while (true)
+            {
+                p = skip_whitespace(parser.parse_value(p, end), end);
+                if (p == end)
+                    return;
+                if (*p != ',')
+                    throw(Exception("parse miss comma or square bracket"));
+                p = skip_whitespace(p + 1, end);
+            }
+        }
+
+        void decode_parallel(Value &result, std::string_view content, unsigned threads)
+        {
+            if (threads == 0)
+                threads = std::max(std::thread::hardware_concurrency(), 1u);
+            // several parts per thread even out elements of different sizes
+            std::vector<size_t> bounds;
+            if (threads > 1)
+                bounds = split_array(content.data(), content.size(), threads * 4);
+            const char *begin = content.data(), *end = begin + content.size();
+            if (bounds.size() < 3 || skip_whitespace(begin, end) != begin + bounds.front() ||
+                skip_whitespace(begin + bounds.back() + 1, end) != end)
+            {
+                result.decode(content);
+                return;
+            }
+
+            size_t parts = bounds.size() - 1;
+            std::vector<std::vector<Value>> elements(parts);
+            std::atomic<size_t> next{0};
+            std::atomic<bool> failed{false};
+            std::exception_ptr failure;
+
+            auto work = [&] {
+                TreeBuilder builder(std::pmr::get_default_resource());
+                Parser<TreeBuilder> parser(builder);
+                for (size_t i; !failed && (i = next++) < parts;)
+                {
+                    try
+                    {
+                        parse_elements(parser, begin + bounds[i] + 1, begin + bounds[i + 1]);
+                        elements[i] = std::move(builder.values());
+                        builder.clear();
+                    }
+                    catch (const Exception &)
+                    {
+                        failed = true;
+                    }
+                    catch (...)
+                    {
+                        if (!failed.exchange(true))
+                            failure = std::current_exception();
+                    }
+                }
+            };
+            std::vector<std::thread> workers;
+            for (unsigned i = 1; i < threads; ++i)
+                workers.emplace_back(work);
+            work();
+            for (std::thread &worker : workers)
+                worker.join();
+
+            if (failure)
+                std::rethrow_exception(failure);
+            // reparse for the message and position the sequential parser reports
+            if (failed)
+            {
+                result.decode(content);
+                return;
+            }
+
+            size_t count = 0;
+            for (const auto &part : elements)
+                count += part.size();
+            std::pmr::vector<Value> arr(result.get_allocator().resource());
+            arr.reserve(count);
+            for (auto &part : elements)
+            {
+                for (Value &v : part)
+                    arr.push_back(std::move(v));
+                std::vector<Value>().swap(part);
+            }
+            result.set_array(arr.data(), arr.size());
+        }
+    }
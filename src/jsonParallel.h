@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string_view>
+
+#include "jsonValue.h"
+
+namespace UT::json {
+        // Decodes content into result, parsing the elements of a root array on threads
+        // workers. Other documents, and any document with an error, go through
+        // Value::decode, so results and error messages are the same.
+        void decode_parallel(Value& result, std::string_view content, unsigned threads);
+    }
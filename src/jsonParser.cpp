@@ -1,11 +1,15 @@
+#include <algorithm>
 #include <cassert>
 #include <cctype>
-#include <errno.h>
-#include <cmath>
-#include <cstdlib>
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include <system_error>
+#include <utility>
 
 #include "jsonException.h"
 #include "jsonParser.h"
+#include "jsonSimd.h"
 
 namespace UT::json
     {
@@ -15,22 +19,57 @@ namespace UT::json
             ++c;
         }
 
-        Parser::Parser(Value &val, const std::string &content) : val_(val), cur_(content.c_str())
+        template <typename Handler>
+        Parser<Handler>::Parser(Handler &handler, std::string_view content) : handler_(handler)
         {
-            val_.set_type(json::type::Null);
+            parse(content);
+        }
+
+        template <typename Handler>
+        Parser<Handler>::Parser(Handler &handler) noexcept : handler_(handler) {}
+
+        template <typename Handler>
+        void Parser<Handler>::parse(std::string_view content)
+        {
+            cur_ = content.data();
+            end_ = content.data() + content.size();
             parse_whitespace();
             parse_value();
             parse_whitespace();
 
-            if (*cur_ != '\0')
-            {
-                val_.set_type(json::type::Null);
+            if (cur_ != end_)
                 throw(Exception("parse root not singular"));
-            }
         }
 
-        void Parser::parse_value()
+        template <typename Handler>
+        Parser<Handler>::Parser(Handler &handler, const char *value, const char *end) : handler_(handler)
         {
+            parse_value(value, end);
+        }
+
+        template <typename Handler>
+        const char *Parser<Handler>::parse_value(const char *value, const char *end)
+        {
+            cur_ = value;
+            end_ = end;
+            parse_value();
+            return cur_;
+        }
+
+        template <typename Handler>
+        const char *Parser<Handler>::parse_key(const char *key, const char *end)
+        {
+            cur_ = key;
+            end_ = end;
+            parse_key();
+            return cur_;
+        }
+
+        template <typename Handler>
+        void Parser<Handler>::parse_value()
+        {
+            if (cur_ == end_)
+                throw Exception("parse expect value");
             switch (*cur_)
             {
             case 'n':
@@ -54,92 +93,164 @@ namespace UT::json
             default:
                 parse_number();
                 return;
-            case '\0':
-                throw Exception("parse expect value");
             }
         }
 
-        void Parser::parse_whitespace() noexcept
+        template <typename Handler>
+        void Parser<Handler>::parse_whitespace() noexcept
         {
-            while (*cur_ == ' ' || *cur_ == '\t' || *cur_ == '\n' || *cur_ == '\r')
+            while (cur_ != end_ && (*cur_ == ' ' || *cur_ == '\t' || *cur_ == '\n' || *cur_ == '\r'))
                 ++cur_;
         }
 
-        void Parser::parse_literal(const char *literal, json::type t)
+        template <typename Handler>
+        void Parser<Handler>::parse_literal(const char *literal, json::type t)
         {
             expect(cur_, literal[0]);
             size_t i;
             for (i = 0; literal[i + 1]; ++i)
             {
-                if (cur_[i] != literal[i + 1])
+                if (cur_ + i == end_ || cur_[i] != literal[i + 1])
                     throw(Exception("parse invalid value"));
             }
             cur_ += i;
-            val_.set_type(t);
+            if (t == json::type::Null)
+                handler_.on_null();
+            else
+                handler_.on_bool(t == json::type::True);
+        }
+
+        static bool is_digit(char c) noexcept
+        {
+            return static_cast<unsigned>(c - '0') < 10;
         }
 
-        void Parser::parse_number()
+        // Powers of ten that are exact doubles; for a mantissa below 2^53 one multiplication
+        // or division by them is correctly rounded (Clinger's fast path).
+        static const double exact_pow10[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+        template <typename Handler>
+        void Parser<Handler>::parse_number()
         {
+            // the value is mantissa * 10^exponent; digits past the 19th are dropped from
+            // the mantissa and send the number to the slow path
             const char *p = cur_;
-            if (*p == '-')
+            uint64_t mantissa = 0;
+            int digits = 0;
+            long exponent = 0;
+            bool truncated = false;
+
+            bool negative = *p == '-';
+            if (negative)
                 ++p;
-            if (*p == '0')
+            if (at(p) == '0')
                 ++p;
             else
             {
-                if (!isdigit(*p))
+                if (!is_digit(at(p)))
                     throw(Exception("parse invalid value"));
-                while (isdigit(*++p))
-                    ;
+                for (; is_digit(at(p)); ++p)
+                {
+                    if (digits < 19)
+                    {
+                        mantissa = mantissa * 10 + (*p - '0');
+                        ++digits;
+                    }
+                    else
+                    {
+                        truncated |= *p != '0';
+                        ++exponent;
+                    }
+                }
             }
 
-            if (*p == '.')
+            if (at(p) == '.')
             {
-                if (!isdigit(*++p))
+                if (!is_digit(at(++p)))
                     throw(Exception("parse invalid value"));
-                while (isdigit(*++p))
-                    ;
+                for (; is_digit(at(p)); ++p)
+                {
+                    if (digits < 19)
+                    {
+                        mantissa = mantissa * 10 + (*p - '0');
+                        digits += mantissa != 0;
+                        --exponent;
+                    }
+                    else
+                        truncated |= *p != '0';
+                }
             }
 
-            if (*p == 'e' || *p == 'E')
+            if (at(p) == 'e' || at(p) == 'E')
             {
                 ++p;
-                if (*p == '+' || *p == '-')
+                bool negative_exponent = at(p) == '-';
+                if (at(p) == '+' || at(p) == '-')
                     ++p;
-                if (!isdigit(*p))
+                if (!is_digit(at(p)))
                     throw(Exception("parse invalid value"));
-                while (isdigit(*++p))
-                    ;
+                long e = 0;
+                for (; is_digit(at(p)); ++p)
+                {
+                    if (e < 100000)
+                        e = e * 10 + (*p - '0');
+                }
+                exponent += negative_exponent ? -e : e;
             }
 
-            errno = 0;
-            double v = strtod(cur_, nullptr);
-            if (errno == ERANGE && (v == HUGE_VAL || v == -HUGE_VAL))
-                throw(Exception("parse number too big"));
+            double v;
+            if (!truncated && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+            {
+                v = static_cast<double>(mantissa);
+                v = exponent < 0 ? v / exact_pow10[-exponent] : v * exact_pow10[exponent];
+                if (negative)
+                    v = -v;
+            }
+            else
+            {
+                auto result = std::from_chars(cur_, p, v);
+                if (result.ec == std::errc::result_out_of_range)
+                {
+                    if (exponent + digits - 1 > 0)
+                        throw(Exception("parse number too big"));
+                    v = negative ? -0.0 : 0.0;
+                }
+            }
 
-            val_.set_number(v);
             cur_ = p;
+            handler_.on_number(v);
         }
 
-        void Parser::parse_string()
+        template <typename Handler>
+        void Parser<Handler>::parse_string()
         {
-            std::string s;
-            parse_string_raw(s);
-            val_.set_string(s);
+            string_.clear();
+            parse_string_raw(string_);
+            handler_.on_string(string_);
         }
 
-        void Parser::parse_string_raw(std::string &tmp)
+        template <typename Handler>
+        void Parser<Handler>::parse_string_raw(std::string &tmp)
         {
             expect(cur_, '\"');
             const char *p = cur_;
             unsigned u = 0, u2 = 0;
-            while (*p != '\"')
+            while (true)
             {
-                if (*p == '\0')
+                const char *q = simd::scan_string(p, end_);
+                tmp.append(p, q);
+                p = q;
+                if (p == end_)
                     throw(Exception("parse miss quotation mark"));
+                if (*p == '\"')
+                    break;
 
-                if (*p == '\\' && ++p)
+                if (*p == '\\')
                 {
+                    if (++p == end_)
+                        throw(Exception("parse miss quotation mark"));
                     switch (*p++)
                     {
                     case '\"':
@@ -170,11 +281,9 @@ namespace UT::json
                         parse_hex4(p, u);
                         if (u >= 0xD800 && u <= 0xDBFF)
                         {
-                            if (*p++ != '\\')
+                            if (at(p) != '\\' || at(++p) != 'u')
                                 throw(Exception("parse invalid unicode surrogate"));
-                            if (*p++ != 'u')
-                                throw(Exception("parse invalid unicode surrogate"));
-                            parse_hex4(p, u2);
+                            parse_hex4(++p, u2);
 
                             if (u2 < 0xDC00 || u2 > 0xDFFF)
                                 throw(Exception("parse invalid unicode surrogate"));
@@ -187,20 +296,19 @@ namespace UT::json
                         throw(Exception("parse invalid string escape"));
                     }
                 }
-                else if ((unsigned char)*p < 0x20)
-                {
-                    throw(Exception("parse invalid string char"));
-                }
                 else
-                    tmp += *p++;
+                    throw(Exception("parse invalid string char"));
             }
             cur_ = ++p;
         }
 
-        void Parser::parse_hex4(const char* &p, unsigned &u) {
+        template <typename Handler>
+        void Parser<Handler>::parse_hex4(const char* &p, unsigned &u) {
             u = 0;
             for(int i = 0; i < 4; ++i) {
-                char ch = *p++;
+                char ch = at(p);
+                if (p != end_)
+                    ++p;
                 u <<= 4;
                 if(isdigit(ch))
                     u |= ch - '0';
@@ -213,7 +321,8 @@ namespace UT::json
             }
         }
 
-        void Parser::parse_encode_utf8(std::string &str, unsigned u) const noexcept {
+        template <typename Handler>
+        void Parser<Handler>::parse_encode_utf8(std::string &str, unsigned u) const noexcept {
             if(u <= 0x7F)
                 str += static_cast<char>(u & 0xFF);
             else if(u <= 0x7FF) {
@@ -232,92 +341,203 @@ namespace UT::json
             }
         }
 
-        void Parser::parse_array() {
+        template <typename Handler>
+        void Parser<Handler>::parse_array() {
             expect(cur_, '[');
+            handler_.on_start_array();
             parse_whitespace();
-            std::vector<Value> tmp;
-            if(*cur_ == ']') {
+            if(at(cur_) == ']') {
                 ++cur_;
-                val_.set_array(tmp);
+                handler_.on_end_array(0);
                 return;
             }
 
-            while(true) {
-                try
-                {
-                    parse_value();
-                }
-                catch(const Exception&)
-                {
-                    val_.set_type(json::type::Null);
-                    throw;
-                }
-                tmp.push_back(val_);
+            for(size_t count = 1;; ++count) {
+                parse_value();
                 parse_whitespace();
-                if(*cur_ == ',') {
+                if(at(cur_) == ',') {
                     ++cur_;
                     parse_whitespace();
-                } else if(*cur_ == ']') {
+                } else if(at(cur_) == ']') {
                     ++cur_;
-                    val_.set_array(tmp);
+                    handler_.on_end_array(count);
                     return;
-                } else {
-                    val_.set_type(json::type::Null);
+                } else
                     throw(Exception("parse miss comma or square bracket"));
-                }
             }
         }
 
-        void Parser::parse_object() {
+        template <typename Handler>
+        void Parser<Handler>::parse_key() {
+            if(at(cur_) != '\"')
+                throw(Exception("parse miss key"));
+            string_.clear();
+            try {
+                parse_string_raw(string_);
+            } catch(const Exception&) {
+                throw(Exception("parse miss key"));
+            }
+            handler_.on_key(string_);
+        }
+
+        template <typename Handler>
+        void Parser<Handler>::parse_object() {
             expect(cur_, '{');
+            handler_.on_start_object();
             parse_whitespace();
-            std::vector<std::pair<std::string, Value>> tmp;
-            std::string key;
-            if(*cur_ == '}') {
+            if(at(cur_) == '}') {
                 ++cur_;
-                val_.set_object(tmp);
+                handler_.on_end_object(0);
                 return;
             }
 
-            while(1) {
-                if(*cur_ != '\"')
-                    throw(Exception("parse miss key"));
-                try {
-                    parse_string_raw(key);
-                } catch(Exception) {
-                    throw(Exception("parse miss key"));
-                }
-
+            for(size_t count = 1;; ++count) {
+                parse_key();
                 parse_whitespace();
 
-                if(*cur_++ != ':')
+                if(at(cur_) != ':')
                     throw(Exception("parse miss colon"));
+                ++cur_;
                 parse_whitespace();
 
-                try{
-                    parse_value();
-                } catch(Exception) {
-                    val_.set_type(json::type::Null);
-                    throw;
-                }
-
-                tmp.push_back(make_pair(key, val_));
-                val_.set_type(json::type::Null);
-                key.clear();
+                parse_value();
 
                 parse_whitespace();
-                if(*cur_ == ',') {
+                if(at(cur_) == ',') {
                     ++cur_;
                     parse_whitespace();
-                } else if(*cur_ == '}') {
+                } else if(at(cur_) == '}') {
                     ++cur_;
-                    val_.set_object(tmp);
+                    handler_.on_end_object(count);
                     return;
-                } else {
-                    val_.set_type(json::type::Null);
+                } else
                     throw(Exception("parse miss comma or curly bracket"));
-                }
-                
             }
         }
+
+        TreeBuilder::TreeBuilder(std::pmr::memory_resource *resource, bool intern_keys) noexcept
+            : resource_(resource), intern_keys_(intern_keys) {}
+
+        void TreeBuilder::on_null()
+        {
+            values_.emplace_back(Value::allocator_type(resource_));
+        }
+
+        void TreeBuilder::on_bool(bool b)
+        {
+            values_.emplace_back(Value::allocator_type(resource_)).set_type(b ? type::True : type::False);
+        }
+
+        void TreeBuilder::on_number(double d)
+        {
+            values_.emplace_back(Value::allocator_type(resource_)).set_number(d);
+        }
+
+        void TreeBuilder::on_string(std::string_view str)
+        {
+            values_.emplace_back(Value::allocator_type(resource_)).set_string(str);
+        }
+
+        void TreeBuilder::on_key(std::string_view key)
+        {
+            key_text_.append(key);
+            key_ends_.push_back(key_text_.size());
+        }
+
+        void TreeBuilder::on_end_array(size_t count)
+        {
+            Value arr(resource_);
+            arr.set_array(values_.data() + values_.size() - count, count);
+            values_.erase(values_.end() - count, values_.end());
+            values_.push_back(std::move(arr));
+        }
+
+        void TreeBuilder::on_end_object(size_t count)
+        {
+            auto first_key = key_ends_.end() - count;
+            size_t begin = first_key == key_ends_.begin() ? 0 : first_key[-1];
+            key_views_.clear();
+            for (size_t i = 0; i < count; ++i)
+            {
+                key_views_.emplace_back(key_text_.data() + begin, first_key[i] - begin);
+                begin = first_key[i];
+                if (intern_keys_ && key_views_.back().size() > Key::inline_size)
+                    key_views_.back() = intern(key_views_.back(), i);
+            }
+            Value obj(resource_);
+            obj.set_object(key_views_.data(), values_.data() + values_.size() - count, count, intern_keys_);
+            values_.erase(values_.end() - count, values_.end());
+            key_text_.resize(first_key == key_ends_.begin() ? 0 : first_key[-1]);
+            key_ends_.erase(first_key, key_ends_.end());
+            values_.push_back(std::move(obj));
+        }
+
+        // Records in an array usually repeat their keys in the same order, so the key last
+        // interned at the same position is tried before the table.
+        std::string_view TreeBuilder::intern(std::string_view key, size_t position)
+        {
+            if (position >= recent_.size())
+                recent_.resize(position + 1);
+            if (recent_[position] == key)
+                return recent_[position];
+
+            auto found = interned_.find(key);
+            if (found == interned_.end())
+            {
+                char *text = static_cast<char *>(resource_->allocate(key.size(), 1));
+                std::copy(key.begin(), key.end(), text);
+                found = interned_.emplace(text, key.size()).first;
+            }
+            return recent_[position] = *found;
+        }
+
+        Value &TreeBuilder::root() noexcept
+        {
+            assert(values_.size() == 1);
+            return values_.back();
+        }
+
+        void TreeBuilder::clear() noexcept
+        {
+            values_.clear();
+            key_text_.clear();
+            key_ends_.clear();
+        }
+
+        void TreeBuilder::reset(std::pmr::memory_resource *resource) noexcept
+        {
+            clear();
+            resource_ = resource;
+            interned_.clear();
+            recent_.clear();
+        }
+
+        void TreeBuilder::push(Value &&v)
+        {
+            values_.push_back(std::move(v));
+        }
+
+        Decoder::Decoder() noexcept : builder_(std::pmr::get_default_resource()), parser_(builder_) {}
+
+        void Decoder::decode(std::string_view content, Value &result)
+        {
+            result.set_type(type::Null);
+            builder_.reset(result.get_allocator().resource());
+            try
+            {
+                parser_.parse(content);
+            }
+            catch (...)
+            {
+                // the partial values may use result's arena, which can go away before the next call
+                builder_.clear();
+                throw;
+            }
+            result = std::move(builder_.root());
+            builder_.clear();
+        }
+
+        template class Parser<TreeBuilder>;
+        template class Parser<JsonHandler>;
+        template class Parser<Validator>;
     }
@@ -1,16 +1,41 @@
 #pragma once
 
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include "json.h"
 #include "jsonValue.h"
 
 namespace UT
 {
     namespace json {
+        // Validates a document and reports it to Handler as JsonHandler events. Instantiated
+        // for TreeBuilder (Value::decode), JsonHandler (UT::decode) and Validator.
+        template <typename Handler>
         class Parser final {
             public:
-                Parser(Value& val, const std::string& content);
-            
+                Parser(Handler& handler, std::string_view content);
+                // parses documents one after another with parse(), keeping its buffers
+                explicit Parser(Handler& handler) noexcept;
+                void parse(std::string_view content);
+                // parses the single value at value and stops after it
+                Parser(Handler& handler, const char* value, const char* end);
+                // the same for a parser kept across values; returns where it stopped
+                const char* parse_value(const char* value, const char* end);
+                // parses the string at key and reports it with on_key
+                const char* parse_key(const char* key, const char* end);
+
+                // where parsing stopped
+                const char* position() const noexcept { return cur_; }
+
             private:
+                // the byte at p, or NUL at the end of the input
+                char at(const char* p) const noexcept { return p != end_ ? *p : '\0'; }
                 void parse_whitespace() noexcept;
                 void parse_value();
                 void parse_literal(const char* literal, json::type t);
@@ -20,10 +45,85 @@ namespace UT
                 void parse_hex4(const char* &p, unsigned &u);
                 void parse_encode_utf8(std::string &s, unsigned u) const noexcept;
                 void parse_array();
+                void parse_key();
                 void parse_object();
 
-                Value &val_;
-                const char* cur_;
+                Handler &handler_;
+                const char* cur_ = nullptr;
+                const char* end_ = nullptr;
+
+                // decoded text of the current string or key
+                std::string string_;
+        };
+
+        // Collects finished values on a stack; a container takes its children off the top
+        // when it closes, so each container is allocated once, at its final size.
+        class TreeBuilder final {
+            public:
+                // with intern_keys, each distinct key longer than the inline size is stored
+                // once in resource and shared by every object; see Value::decode_interned
+                explicit TreeBuilder(std::pmr::memory_resource* resource, bool intern_keys = false) noexcept;
+
+                void on_null();
+                void on_bool(bool b);
+                void on_number(double d);
+                void on_string(std::string_view str);
+                void on_start_array() noexcept {}
+                void on_end_array(size_t count);
+                void on_start_object() noexcept {}
+                void on_key(std::string_view key);
+                void on_end_object(size_t count);
+
+                void push(Value&& v);
+                Value& root() noexcept;
+                // the finished values not yet taken by a container, oldest first
+                std::vector<Value>& values() noexcept { return values_; }
+                // drops everything, keeping the stacks' capacity for the next document
+                void clear() noexcept;
+                // the same, and builds the next document in resource
+                void reset(std::pmr::memory_resource* resource) noexcept;
+
+            private:
+                std::string_view intern(std::string_view key, size_t position);
+
+                std::pmr::memory_resource* resource_;
+                std::vector<Value> values_;
+                // pending keys, back to back, and where each one ends
+                std::string key_text_;
+                std::vector<size_t> key_ends_;
+                std::vector<std::string_view> key_views_;
+                bool intern_keys_;
+                std::unordered_set<std::string_view> interned_;
+                std::vector<std::string_view> recent_;
+        };
+
+        // checks a document without keeping anything
+        struct Validator final {
+            void on_null() noexcept {}
+            void on_bool(bool) noexcept {}
+            void on_number(double) noexcept {}
+            void on_string(std::string_view) noexcept {}
+            void on_start_array() noexcept {}
+            void on_end_array(size_t) noexcept {}
+            void on_start_object() noexcept {}
+            void on_key(std::string_view) noexcept {}
+            void on_end_object(size_t) noexcept {}
+        };
+
+        extern template class Parser<TreeBuilder>;
+        extern template class Parser<JsonHandler>;
+        extern template class Parser<Validator>;
+
+        // Decodes documents one after another, keeping the parser's and the builder's
+        // buffers between them; see JsonParser.
+        class Decoder final {
+            public:
+                Decoder() noexcept;
+                void decode(std::string_view content, Value& result);
+
+            private:
+                TreeBuilder builder_;
+                Parser<TreeBuilder> parser_;
         };
     }
 } // namespace UT
@@ -0,0 +1,359 @@
+#include <utility>
+
+#include "jsonException.h"
+#include "jsonPushParser.h"
+#include "jsonSimd.h"
+
+namespace UT::json
+    {
+        static bool is_whitespace(char c) noexcept
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        static bool is_digit(char c) noexcept
+        {
+            return static_cast<unsigned>(c - '0') < 10;
+        }
+
+        PushParser::PushParser() noexcept : builder_(std::pmr::get_default_resource()), parser_(builder_) {}
+
+        void PushParser::feed(const char *p, const char *end)
+        {
+            try
+            {
+                while (p != end)
+                {
+                    if (token_ != token::None)
+                        p = continue_token(p, end);
+                    else if (is_whitespace(*p))
+                        ++p;
+                    else
+                        p = structural(p);
+                }
+            }
+            catch (const Exception &)
+            {
+                reset();
+                throw;
+            }
+        }
+
+        void PushParser::finish(Value &result)
+        {
+            try
+            {
+                switch (token_)
+                {
+                case token::String:
+                case token::Key:
+                    // an unterminated string; decoding it reports the first problem in it
+                    end_token();
+                    break;
+                case token::Number:
+                    if (number_ != number::Zero && number_ != number::Int && number_ != number::Frac && number_ != number::ExpDigits)
+                        throw(Exception("parse invalid value"));
+                    end_token();
+                    break;
+                case token::Literal:
+                    throw(Exception("parse invalid value"));
+                case token::None:
+                    break;
+                }
+
+                switch (state_)
+                {
+                case state::Value:
+                case state::ArrayFirst:
+                    throw(Exception("parse expect value"));
+                case state::ArrayNext:
+                    throw(Exception("parse miss comma or square bracket"));
+                case state::ObjectFirst:
+                case state::ObjectKey:
+                    throw(Exception("parse miss key"));
+                case state::Colon:
+                    throw(Exception("parse miss colon"));
+                case state::ObjectNext:
+                    throw(Exception("parse miss comma or curly bracket"));
+                case state::Done:
+                    break;
+                }
+            }
+            catch (const Exception &)
+            {
+                reset();
+                throw;
+            }
+
+            result = std::move(builder_.root());
+            reset();
+        }
+
+        void PushParser::reset() noexcept
+        {
+            state_ = state::Value;
+            token_ = token::None;
+            text_.clear();
+            escaped_ = false;
+            frames_.clear();
+            builder_.clear();
+        }
+
+        const char *PushParser::structural(const char *p)
+        {
+            switch (state_)
+            {
+            case state::Done:
+                throw(Exception("parse root not singular"));
+            case state::Colon:
+                if (*p != ':')
+                    throw(Exception("parse miss colon"));
+                state_ = state::Value;
+                return p + 1;
+            case state::ArrayNext:
+                if (*p == ',')
+                    state_ = state::Value;
+                else if (*p == ']')
+                    close_array();
+                else
+                    throw(Exception("parse miss comma or square bracket"));
+                return p + 1;
+            case state::ObjectNext:
+                if (*p == ',')
+                    state_ = state::ObjectKey;
+                else if (*p == '}')
+                    close_object();
+                else
+                    throw(Exception("parse miss comma or curly bracket"));
+                return p + 1;
+            case state::ObjectFirst:
+                if (*p == '}')
+                {
+                    close_object();
+                    return p + 1;
+                }
+                [[fallthrough]];
+            case state::ObjectKey:
+                if (*p != '\"')
+                    throw(Exception("parse miss key"));
+                token_ = token::Key;
+                text_.assign(1, '\"');
+                return p + 1;
+            case state::ArrayFirst:
+                if (*p == ']')
+                {
+                    close_array();
+                    return p + 1;
+                }
+                [[fallthrough]];
+            case state::Value:
+                break;
+            }
+            return start_value(p);
+        }
+
+        const char *PushParser::start_value(const char *p)
+        {
+            switch (*p)
+            {
+            case 'n':
+                literal_ = "null";
+                literal_type_ = type::Null;
+                break;
+            case 't':
+                literal_ = "true";
+                literal_type_ = type::True;
+                break;
+            case 'f':
+                literal_ = "false";
+                literal_type_ = type::False;
+                break;
+            case '\"':
+                token_ = token::String;
+                text_.assign(1, '\"');
+                return p + 1;
+            case '[':
+                frames_.push_back({false, 0});
+                state_ = state::ArrayFirst;
+                return p + 1;
+            case '{':
+                frames_.push_back({true, 0});
+                state_ = state::ObjectFirst;
+                return p + 1;
+            case '\0':
+                throw(Exception("parse expect value"));
+            default:
+                if (*p != '-' && !is_digit(*p))
+                    throw(Exception("parse invalid value"));
+                token_ = token::Number;
+                number_ = number::Start;
+                text_.clear();
+                return p;
+            }
+            token_ = token::Literal;
+            text_.clear();
+            return p;
+        }
+
+        const char *PushParser::continue_token(const char *p, const char *end)
+        {
+            switch (token_)
+            {
+            case token::String:
+            case token::Key:
+                while (p != end)
+                {
+                    if (escaped_)
+                    {
+                        text_ += *p++;
+                        escaped_ = false;
+                        continue;
+                    }
+                    const char *q = simd::scan_string(p, end);
+                    text_.append(p, q);
+                    p = q;
+                    if (p == end)
+                        break;
+                    char c = *p++;
+                    text_ += c;
+                    if (c == '\\')
+                        escaped_ = true;
+                    else if (c == '\"')
+                    {
+                        end_token();
+                        break;
+                    }
+                }
+                return p;
+            case token::Number:
+                for (; p != end; ++p)
+                {
+                    char c = *p;
+                    number next = number::End;
+                    switch (number_)
+                    {
+                    case number::Start:
+                        if (c == '-')
+                        {
+                            next = number::Minus;
+                            break;
+                        }
+                        [[fallthrough]];
+                    case number::Minus:
+                        if (c == '0')
+                            next = number::Zero;
+                        else if (is_digit(c))
+                            next = number::Int;
+                        break;
+                    case number::Int:
+                        if (is_digit(c))
+                            next = number::Int;
+                        [[fallthrough]];
+                    case number::Zero:
+                        if (c == '.')
+                            next = number::Dot;
+                        else if (c == 'e' || c == 'E')
+                            next = number::Exp;
+                        break;
+                    case number::Dot:
+                    case number::Frac:
+                        if (is_digit(c))
+                            next = number::Frac;
+                        else if (number_ == number::Frac && (c == 'e' || c == 'E'))
+                            next = number::Exp;
+                        break;
+                    case number::Exp:
+                        if (c == '+' || c == '-')
+                        {
+                            next = number::ExpSign;
+                            break;
+                        }
+                        [[fallthrough]];
+                    case number::ExpSign:
+                    case number::ExpDigits:
+                        if (is_digit(c))
+                            next = number::ExpDigits;
+                        break;
+                    case number::End:
+                        break;
+                    }
+
+                    if (next == number::End)
+                    {
+                        if (number_ != number::Zero && number_ != number::Int && number_ != number::Frac && number_ != number::ExpDigits)
+                            throw(Exception("parse invalid value"));
+                        end_token();
+                        return p;
+                    }
+                    text_ += c;
+                    number_ = next;
+                }
+                return p;
+            case token::Literal:
+                for (; p != end && literal_[text_.size()]; ++p)
+                {
+                    if (*p != literal_[text_.size()])
+                        throw(Exception("parse invalid value"));
+                    text_ += *p;
+                }
+                if (!literal_[text_.size()])
+                    end_token();
+                return p;
+            case token::None:
+                break;
+            }
+            return p;
+        }
+
+        void PushParser::end_token()
+        {
+            token t = token_;
+            token_ = token::None;
+            escaped_ = false;
+
+            const char *begin = text_.data(), *end = begin + text_.size();
+            switch (t)
+            {
+            case token::Key:
+                parser_.parse_key(begin, end);
+                state_ = state::Colon;
+                return;
+            case token::Literal:
+                if (literal_type_ == type::Null)
+                    builder_.on_null();
+                else
+                    builder_.on_bool(literal_type_ == type::True);
+                break;
+            default:
+                parser_.parse_value(begin, end);
+                break;
+            }
+            end_value();
+        }
+
+        // a value was pushed onto builder_
+        void PushParser::end_value()
+        {
+            if (frames_.empty())
+                state_ = state::Done;
+            else
+            {
+                ++frames_.back().count;
+                state_ = frames_.back().object ? state::ObjectNext : state::ArrayNext;
+            }
+        }
+
+        void PushParser::close_array()
+        {
+            builder_.on_end_array(frames_.back().count);
+            frames_.pop_back();
+            end_value();
+        }
+
+        void PushParser::close_object()
+        {
+            builder_.on_end_object(frames_.back().count);
+            frames_.pop_back();
+            end_value();
+        }
+    }
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "json.h"
+#include "jsonParser.h"
+#include "jsonValue.h"
+
+namespace UT::json {
+        // Accepts a document in arbitrary pieces. Containers are tracked on an explicit
+        // stack; scalars and keys are collected in text_ until they end and are then
+        // handed to parser_, so values and error messages match a whole-document parse.
+        // Finished values wait in builder_ until their container closes.
+        class PushParser final {
+            public:
+                PushParser() noexcept;
+                void feed(const char* p, const char* end);
+                void finish(Value& result);
+                void reset() noexcept;
+
+            private:
+                enum class state : unsigned char {
+                    Value, ArrayFirst, ArrayNext, ObjectFirst, ObjectKey, Colon, ObjectNext, Done
+                };
+                enum class token : unsigned char {
+                    None, String, Key, Number, Literal
+                };
+                enum class number : unsigned char {
+                    Start, Minus, Zero, Int, Dot, Frac, Exp, ExpSign, ExpDigits, End
+                };
+
+                struct Frame {
+                    bool object;
+                    size_t count;
+                };
+
+                const char* structural(const char* p);
+                const char* start_value(const char* p);
+                const char* continue_token(const char* p, const char* end);
+                void end_token();
+                void end_value();
+                void close_array();
+                void close_object();
+
+                state state_ = state::Value;
+                token token_ = token::None;
+                std::string text_;
+                bool escaped_ = false;
+                number number_ = number::Start;
+                const char* literal_ = nullptr;
+                type literal_type_ = type::Null;
+
+                std::vector<Frame> frames_;
+                TreeBuilder builder_;
+                Parser<TreeBuilder> parser_;
+        };
+    }
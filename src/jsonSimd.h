@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define UT_JSON_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UT_JSON_SSE2 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace UT::json::simd {
+        inline unsigned trailing_zeros(uint32_t mask) noexcept
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return index;
+#else
+            return __builtin_ctz(mask);
+#endif
+        }
+
+        inline unsigned trailing_zeros(uint64_t mask) noexcept
+        {
+#if defined(_MSC_VER) && defined(_M_X64)
+            unsigned long index;
+            _BitScanForward64(&index, mask);
+            return index;
+#elif defined(_MSC_VER)
+            uint32_t low = static_cast<uint32_t>(mask);
+            return low != 0 ? trailing_zeros(low) : 32 + trailing_zeros(static_cast<uint32_t>(mask >> 32));
+#else
+            return __builtin_ctzll(mask);
+#endif
+        }
+
+        // Bit i is the xor of bits 0..i: turns quote positions into a mask of string contents.
+        inline uint64_t prefix_xor(uint64_t x) noexcept
+        {
+            x ^= x << 1;
+            x ^= x << 2;
+            x ^= x << 4;
+            x ^= x << 8;
+            x ^= x << 16;
+            x ^= x << 32;
+            return x;
+        }
+
+        // Character classes of a 64-byte block, one bit per byte.
+        struct Block {
+            uint64_t quote;
+            uint64_t backslash;
+            uint64_t whitespace;
+            uint64_t op;
+        };
+
+        inline Block classify(const char* p) noexcept
+        {
+            Block b{0, 0, 0, 0};
+#if defined(UT_JSON_AVX2)
+            for (int i = 0; i < 64; i += 32)
+            {
+                __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+                __m256i folded = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+                __m256i ws = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t'))),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\r'))));
+                __m256i op = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(','))));
+                b.quote |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\"'))))) << i;
+                b.backslash |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\'))))) << i;
+                b.whitespace |= uint64_t(uint32_t(_mm256_movemask_epi8(ws))) << i;
+                b.op |= uint64_t(uint32_t(_mm256_movemask_epi8(op))) << i;
+            }
+#elif defined(UT_JSON_SSE2)
+            for (int i = 0; i < 64; i += 16)
+            {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+                __m128i folded = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+                __m128i ws = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t'))),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r'))));
+                __m128i op = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')), _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(':')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8(','))));
+                b.quote |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\"'))))) << i;
+                b.backslash |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'))))) << i;
+                b.whitespace |= uint64_t(uint32_t(_mm_movemask_epi8(ws))) << i;
+                b.op |= uint64_t(uint32_t(_mm_movemask_epi8(op))) << i;
+            }
+#else
+            for (int i = 0; i < 64; ++i)
+            {
+                uint64_t bit = uint64_t(1) << i;
+                switch (p[i])
+                {
+                case '\"': b.quote |= bit; break;
+                case '\\': b.backslash |= bit; break;
+                case ' ': case '\t': case '\n': case '\r': b.whitespace |= bit; break;
+                case '{': case '}': case '[': case ']': case ':': case ',': b.op |= bit; break;
+                default: break;
+                }
+            }
+#endif
+            return b;
+        }
+
+        // First byte in [p, end) that cannot be copied verbatim from a JSON string:
+        // '"', '\\' or a control character. Returns end if there is none.
+        inline const char* scan_string(const char* p, const char* end) noexcept
+        {
+#if defined(UT_JSON_AVX2)
+            const __m256i quote = _mm256_set1_epi8('\"');
+            const __m256i backslash = _mm256_set1_epi8('\\');
+            const __m256i control = _mm256_set1_epi8(0x1F);
+            for (; end - p >= 32; p += 32)
+            {
+                __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                __m256i special = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+                    _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, control), control));
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+                if (mask != 0)
+                    return p + trailing_zeros(mask);
+            }
+#endif
+#if defined(UT_JSON_SSE2)
+            const __m128i quote16 = _mm_set1_epi8('\"');
+            const __m128i backslash16 = _mm_set1_epi8('\\');
+            const __m128i control16 = _mm_set1_epi8(0x1F);
+            for (; end - p >= 16; p += 16)
+            {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, quote16), _mm_cmpeq_epi8(chunk, backslash16)),
+                    _mm_cmpeq_epi8(_mm_max_epu8(chunk, control16), control16));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+                if (mask != 0)
+                    return p + trailing_zeros(mask);
+            }
+#endif
+            for (; p != end; ++p)
+            {
+                unsigned char ch = static_cast<unsigned char>(*p);
+                if (ch == '\"' || ch == '\\' || ch < 0x20)
+                    return p;
+            }
+            return end;
+        }
+    }
@@ -0,0 +1,86 @@
+#include <cstdint>
+#include <cstring>
+
+#include "jsonSimd.h"
+#include "jsonStructuralIndex.h"
+
+namespace UT::json
+    {
+        // Quotes preceded by an odd number of backslashes are escaped; prev_escaped carries
+        // a run that crosses the block boundary.
+        static uint64_t find_escaped(uint64_t backslash, uint64_t &prev_escaped) noexcept
+        {
+            const uint64_t even_bits = 0x5555555555555555ULL;
+            backslash &= ~prev_escaped;
+            uint64_t follows_escape = backslash << 1 | prev_escaped;
+            uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+            uint64_t sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+            prev_escaped = sequences_starting_on_even_bits < backslash ? 1 : 0;
+            uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+            return (even_bits ^ invert_mask) & follows_escape;
+        }
+
+        std::vector<size_t> split_array(const char *data, size_t size, size_t parts)
+        {
+            std::vector<size_t> bounds;
+            size_t step = size / (parts ? parts : 1), next = step;
+            long depth = 0;
+
+            uint64_t prev_escaped = 0, prev_in_string = 0;
+            char tail[64];
+            for (size_t offset = 0; offset < size; offset += 64)
+            {
+                const char *block = data + offset;
+                if (size - offset < 64)
+                {
+                    memset(tail, ' ', sizeof(tail));
+                    memcpy(tail, block, size - offset);
+                    block = tail;
+                }
+
+                simd::Block b = simd::classify(block);
+                uint64_t quote = b.quote & ~find_escaped(b.backslash, prev_escaped);
+                uint64_t in_string = simd::prefix_xor(quote) ^ prev_in_string;
+                prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+                uint64_t op = b.op & ~in_string;
+                while (op != 0)
+                {
+                    size_t i = offset + simd::trailing_zeros(op);
+                    op &= op - 1;
+                    switch (data[i])
+                    {
+                    case '[':
+                    case '{':
+                        if (depth++ == 0)
+                        {
+                            if (data[i] != '[' || !bounds.empty())
+                                return {};
+                            bounds.push_back(i);
+                        }
+                        break;
+                    case ']':
+                    case '}':
+                        if (--depth == 0)
+                        {
+                            if (data[i] != ']')
+                                return {};
+                            bounds.push_back(i);
+                            return bounds;
+                        }
+                        if (depth < 0)
+                            return {};
+                        break;
+                    case ',':
+                        if (depth == 1 && i >= next)
+                        {
+                            bounds.push_back(i);
+                            next = i + step;
+                        }
+                        break;
+                    }
+                }
+            }
+            return {};
+        }
+    }
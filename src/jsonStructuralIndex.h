@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace UT::json {
+        // For a document whose root is an array: the offsets of its '[', of top-level
+        // commas roughly size / parts apart, and of its ']'. Empty if the root is not an
+        // array or the brackets do not balance.
+        std::vector<size_t> split_array(const char* data, size_t size, size_t parts);
+    }
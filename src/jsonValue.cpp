@@ -1,16 +1,140 @@
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <string>
 
 #include "jsonValue.h"
 #include "jsonParser.h"
 #include "jsonGenerator.h"
+#include "jsonSimd.h"
 
 namespace UT::json
     {
+        static const char *skip_whitespace(const char *p) noexcept
+        {
+            while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+                ++p;
+            return p;
+        }
+
+        // The end of the value that starts at p, in text that has been validated.
+        static const char *skip_value(const char *p, const char *end) noexcept
+        {
+            int depth = 0;
+            do
+            {
+                switch (*p)
+                {
+                case '\"':
+                    for (++p;; p += 2)
+                    {
+                        p = simd::scan_string(p, end);
+                        if (*p == '\"')
+                            break;
+                    }
+                    ++p;
+                    break;
+                case '[':
+                case '{':
+                    ++depth;
+                    ++p;
+                    break;
+                case ']':
+                case '}':
+                    --depth;
+                    ++p;
+                    break;
+                default:
+                    if (depth == 0)
+                    {
+                        while (p != end && *p != ',' && *p != ']' && *p != '}' && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r')
+                            ++p;
+                        return p;
+                    }
+                    ++p;
+                    break;
+                }
+            } while (depth > 0);
+            return p;
+        }
+
+        // Elements live behind a Block header in one allocation of the owner's resource.
+        static constexpr size_t header = 16;
+
+        template <typename T>
+        static T *allocate_block(std::pmr::memory_resource *resource, size_t capacity)
+        {
+            void *p = resource->allocate(header + capacity * sizeof(T), alignof(std::max_align_t));
+            new (p) size_t(capacity);
+            new (static_cast<char *>(p) + 8) ObjectIndex *(nullptr);
+            return reinterpret_cast<T *>(static_cast<char *>(p) + header);
+        }
+
+        template <typename T>
+        static void deallocate_block(std::pmr::memory_resource *resource, T *elements, size_t capacity) noexcept
+        {
+            resource->deallocate(reinterpret_cast<char *>(elements) - header, header + capacity * sizeof(T), alignof(std::max_align_t));
+        }
+
+        static char *copy_text(std::string_view text, std::pmr::memory_resource *resource)
+        {
+            char *p = static_cast<char *>(resource->allocate(text.size(), 1));
+            std::copy(text.begin(), text.end(), p);
+            return p;
+        }
+
+        Key::Key(std::string_view key, std::pmr::memory_resource *resource) noexcept : size_(key.size())
+        {
+            if (size_ <= sizeof(small_))
+                std::copy(key.begin(), key.end(), small_);
+            else
+                data_ = copy_text(key, resource);
+        }
+
+        Key Key::shared(std::string_view text) noexcept
+        {
+            Key key;
+            key.size_ = text.size();
+            if (key.size_ <= sizeof(key.small_))
+                std::copy(text.begin(), text.end(), key.small_);
+            else
+            {
+                key.data_ = const_cast<char *>(text.data());
+                key.size_ |= shared_bit;
+            }
+            return key;
+        }
+
+        void Key::free(std::pmr::memory_resource *resource) noexcept
+        {
+            if (size_ > sizeof(small_) && !(size_ & shared_bit))
+                resource->deallocate(data_, size_, 1);
+        }
+
+        Value::Value(Value &&rhs, const allocator_type &alloc) noexcept
+        {
+            if (*rhs.resource_ == *alloc.resource())
+                init(std::move(rhs));
+            else
+                init(rhs, alloc.resource());
+        }
+
         Value &Value::operator=(const Value &rhs) noexcept
         {
+            Value tmp(rhs, resource_);
             free();
-            init(rhs);
+            init(std::move(tmp));
+            return *this;
+        }
+
+        Value &Value::operator=(Value &&rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                Value tmp(std::move(rhs), resource_);
+                free();
+                init(std::move(tmp));
+            }
             return *this;
         }
 
@@ -19,190 +143,516 @@ namespace UT::json
             free();
         }
 
-        void Value::init(const Value &rhs) noexcept
+        void Value::init(const Value &rhs, std::pmr::memory_resource *resource) noexcept
         {
-            type_ = rhs.type_;
-            num_ = 0;
-            switch (type_)
+            resource_ = resource;
+            if (rhs.is_lazy())
+            {
+                // the copy may outlive the text, so it is decoded completely
+                TreeBuilder builder(resource);
+                Parser<TreeBuilder>(builder, rhs.lazy_, rhs.lazy_ + rhs.size());
+                init(std::move(builder.root()));
+                return;
+            }
+            bits_ = rhs.bits_;
+            size_t n = rhs.size();
+            switch (rhs.tag())
             {
-            case type::Number:
-                num_ = rhs.num_;
-                break;
             case type::String:
-                new (&str_) std::string(rhs.str_);
+                if (n <= inline_size)
+                    std::copy(rhs.small_, rhs.small_ + n, small_);
+                else
+                    str_ = copy_text(rhs.get_string(), resource);
                 break;
             case type::Array:
-                new (&arr_) std::vector<Value>(rhs.arr_);
+                arr_ = n > 0 ? allocate_block<Value>(resource, n) : nullptr;
+                for (size_t i = 0; i < n; ++i)
+                    new (&arr_[i]) Value(rhs.arr_[i], resource);
                 break;
             case type::Object:
-                new (&obj_) std::vector<std::pair<std::string, Value>>(rhs.obj_);
+                obj_ = n > 0 ? allocate_block<Member>(resource, n) : nullptr;
+                for (size_t i = 0; i < n; ++i)
+                    new (&obj_[i]) Member{Key(rhs.obj_[i].key.view(), resource), Value(rhs.obj_[i].value, resource)};
+                index_members();
+                break;
+            default:
+                num_ = rhs.num_;
                 break;
             }
         }
+
+        // takes rhs's payload and resource; *this holds nothing that needs freeing
+        void Value::init(Value &&rhs) noexcept
+        {
+            bits_ = rhs.bits_;
+            resource_ = rhs.resource_;
+            // the payload's bytes, whichever member they hold
+            std::memcpy(small_, rhs.small_, inline_size);
+            rhs.set_bits(type::Null, 0);
+            rhs.num_ = 0;
+        }
+
         void Value::free() noexcept
         {
-            using std::string;
-            switch (type_)
+            size_t n = size();
+            switch (tag())
             {
             case type::String:
-                str_.~string();
+                if (n > inline_size)
+                    resource_->deallocate(str_, n, 1);
                 break;
             case type::Array:
-                arr_.~vector<Value>();
+                if (arr_)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                        arr_[i].~Value();
+                    deallocate_block(resource_, arr_, block()->capacity);
+                }
                 break;
             case type::Object:
-                obj_.~vector<std::pair<std::string, Value>>();
+                if (obj_)
+                {
+                    drop_index();
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        obj_[i].key.free(resource_);
+                        obj_[i].value.~Value();
+                    }
+                    deallocate_block(resource_, obj_, block()->capacity);
+                }
+                break;
+            default:
                 break;
             }
         }
 
-        void Value::decode(const std::string& content)
+        void Value::reset(type t) noexcept
+        {
+            free();
+            set_bits(t, 0);
+            num_ = 0;
+        }
+
+        Value::Block *Value::block() const noexcept
+        {
+            return reinterpret_cast<Block *>(reinterpret_cast<char *>(tag() == type::Array ? static_cast<void *>(arr_) : static_cast<void *>(obj_)) - header);
+        }
+
+        // grows the elements or members of an array or object to at least capacity
+        void Value::reserve(size_t capacity) noexcept
+        {
+            size_t old = arr_ ? block()->capacity : 0;
+            if (capacity <= old)
+                return;
+            capacity = std::max({capacity, old * 2, size_t(4)});
+            size_t n = size();
+            if (tag() == type::Array)
+            {
+                Value *elements = allocate_block<Value>(resource_, capacity);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    new (&elements[i]) Value(std::move(arr_[i]));
+                    arr_[i].~Value();
+                }
+                if (arr_)
+                    deallocate_block(resource_, arr_, old);
+                arr_ = elements;
+            }
+            else
+            {
+                Member *members = allocate_block<Member>(resource_, capacity);
+                ObjectIndex *index = obj_ ? block()->index : nullptr;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    new (&members[i]) Member{obj_[i].key, std::move(obj_[i].value)};
+                    obj_[i].value.~Value();
+                }
+                if (obj_)
+                    deallocate_block(resource_, obj_, old);
+                obj_ = members;
+                block()->index = index;
+            }
+        }
+
+        void Value::index_members() noexcept
+        {
+            if (size() < ObjectIndex::threshold || block()->index)
+                return;
+            std::pmr::polymorphic_allocator<ObjectIndex> alloc(resource_);
+            block()->index = alloc.allocate(1);
+            new (block()->index) ObjectIndex(obj_, size(), resource_);
+        }
+
+        void Value::drop_index() noexcept
+        {
+            if (obj_ && block()->index)
+            {
+                std::pmr::polymorphic_allocator<ObjectIndex> alloc(resource_);
+                block()->index->~ObjectIndex();
+                alloc.deallocate(block()->index, 1);
+                block()->index = nullptr;
+            }
+        }
+
+        void Value::decode(std::string_view content)
         {
-            Parser(*this, content);
+            set_type(type::Null);
+            TreeBuilder builder(resource_);
+            Parser<TreeBuilder>(builder, content);
+            *this = std::move(builder.root());
+        }
+        void Value::decode_interned(std::string_view content)
+        {
+            set_type(type::Null);
+            TreeBuilder builder(resource_, true);
+            Parser<TreeBuilder>(builder, content);
+            *this = std::move(builder.root());
         }
         void Value::stringify(std::string &content) const noexcept
+        {
+            content.clear();
+            Generator(*this, content);
+        }
+        void Value::stringify_append(std::string &content) const noexcept
         {
             Generator(*this, content);
         }
+        void Value::stringify(const Sink &sink) const
+        {
+            std::string buffer;
+            Generator(*this, buffer, sink);
+        }
+
+        void Value::decode_lazy(const char* text, size_t size)
+        {
+            set_type(type::Null);
+            Validator validator;
+            Parser<Validator>(validator, std::string_view(text, size));
+
+            const char *p = text;
+            while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+                ++p;
+            if (*p == '[' || *p == '{')
+                *this = lazy(p, skip_value(p, text + size), resource_);
+            else
+            {
+                TreeBuilder builder(resource_);
+                Parser<TreeBuilder>(builder, p, text + size);
+                *this = std::move(builder.root());
+            }
+        }
+
+        Value Value::lazy(const char* begin, const char* end, std::pmr::memory_resource* resource) noexcept
+        {
+            Value v(resource);
+            v.set_bits(*begin == '[' ? lazy_array : lazy_object, end - begin);
+            v.lazy_ = begin;
+            return v;
+        }
+
+        // Builds one level: nested arrays and objects become lazy values themselves.
+        void Value::expand() const
+        {
+            const char *begin = lazy_, *text_end = lazy_ + size();
+            bool object = tag() == lazy_object;
+            TreeBuilder builder(resource_);
+            size_t count = 0;
+            const char *p = skip_whitespace(begin + 1);
+            while (*p != ']' && *p != '}')
+            {
+                if (object)
+                {
+                    const char *key_end = skip_value(p, text_end);
+                    if (std::find(p, key_end, '\\') == key_end)
+                        builder.on_key(std::string_view(p + 1, key_end - p - 2));
+                    else
+                    {
+                        TreeBuilder key(resource_);
+                        Parser<TreeBuilder>(key, p, key_end);
+                        builder.on_key(key.root().get_string());
+                    }
+                    p = skip_whitespace(skip_whitespace(key_end) + 1);
+                }
+
+                const char *end = skip_value(p, text_end);
+                if (*p == '[' || *p == '{')
+                    builder.push(lazy(p, end, resource_));
+                else
+                    Parser<TreeBuilder>(builder, p, end);
+                ++count;
+
+                p = skip_whitespace(end);
+                if (*p == ',')
+                    p = skip_whitespace(p + 1);
+            }
+            if (object)
+                builder.on_end_object(count);
+            else
+                builder.on_end_array(count);
+
+            Value *self = const_cast<Value *>(this);
+            self->init(std::move(builder.root()));
+        }
+
+        Value::allocator_type Value::get_allocator() const noexcept
+        {
+            return resource_;
+        }
 
         type Value::get_type() const noexcept
         {
-            return type_;
+            if (tag() == lazy_array)
+                return type::Array;
+            if (tag() == lazy_object)
+                return type::Object;
+            return tag();
         }
 
         void Value::set_type(type t) noexcept
         {
-            type_ = t;
+            reset(t);
         }
 
         double Value::get_number() const noexcept
         {
-            assert(type_ == type::Number);
+            assert(tag() == type::Number);
             return num_;
         }
 
         void Value::set_number(double d) noexcept
         {
-            free();
-            type_ = type::Number;
+            reset(type::Number);
             num_ = d;
         }
 
-        const std::string &Value::get_string() const noexcept
+        std::string_view Value::get_string() const noexcept
         {
-            assert(type_ == type::String);
-            return str_;
+            assert(tag() == type::String);
+            return {size() <= inline_size ? small_ : str_, size()};
         }
 
-        void Value::set_string(const std::string& str) noexcept
+        void Value::set_string(std::string_view str) noexcept
         {
-            if(type_ == type::String)
-                str_ = str;
-            else {
-                free();
-                type_ = type::String;
-                new(&str_) std::string(str);
-            }
+            // str may point into this value
+            char *heap = str.size() > inline_size ? copy_text(str, resource_) : nullptr;
+            char small[inline_size];
+            std::copy(str.begin(), str.begin() + std::min(str.size(), inline_size), small);
+            free();
+            set_bits(type::String, str.size());
+            if (heap)
+                str_ = heap;
+            else
+                std::copy(small, small + str.size(), small_);
         }
 
         size_t Value::get_array_size() const noexcept
         {
-            assert(type_ == type::Array);
-            return arr_.size();
+            expand_if_lazy();
+            assert(tag() == type::Array);
+            return size();
         }
 
         const Value& Value::get_array_element(size_t index) const noexcept
         {
-            assert(type_ == type::Array);
+            expand_if_lazy();
+            assert(tag() == type::Array);
             return arr_[index];
         }
-        void Value::set_array(const std::vector<Value> &arr) noexcept
+
+        void Value::set_array(const std::pmr::vector<Value> &arr) noexcept
         {
-            if(type_ == type::Array) {
-                arr_ = arr;
-            } else {
-                free();
-                type_ = type::Array;
-                new(&arr_) std::vector<Value>(arr);
-            }
+            Value tmp(resource_);
+            tmp.set_bits(type::Array, 0);
+            tmp.arr_ = nullptr;
+            tmp.reserve(arr.size());
+            for (const Value &v : arr)
+                new (&tmp.arr_[tmp.size()]) Value(v, resource_), tmp.set_bits(type::Array, tmp.size() + 1);
+            free();
+            init(std::move(tmp));
+        }
+
+        void Value::set_array(std::pmr::vector<Value> &&arr) noexcept
+        {
+            if (*arr.get_allocator().resource() == *resource_)
+                set_array(arr.data(), arr.size());
+            else
+                set_array(arr);
+        }
+
+        void Value::set_array(Value *values, size_t count) noexcept
+        {
+            Value *elements = count > 0 ? allocate_block<Value>(resource_, count) : nullptr;
+            for (size_t i = 0; i < count; ++i)
+                new (&elements[i]) Value(std::move(values[i]), resource_);
+            free();
+            set_bits(type::Array, count);
+            arr_ = elements;
         }
 
         void Value::push_back_array_element(const Value &val) noexcept
         {
-            assert(type_ == type::Array);
-            arr_.push_back(val);
+            push_back_array_element(Value(val, resource_));
+        }
+
+        void Value::push_back_array_element(Value &&val) noexcept
+        {
+            expand_if_lazy();
+            assert(tag() == type::Array);
+            // val may be one of the elements
+            Value element(std::move(val), resource_);
+            size_t n = size();
+            reserve(n + 1);
+            new (&arr_[n]) Value(std::move(element));
+            set_bits(type::Array, n + 1);
         }
 
         void Value::pop_back_array_element() noexcept
         {
-            assert(type_ == type::Array);
-            arr_.pop_back();
+            expand_if_lazy();
+            assert(tag() == type::Array && size() > 0);
+            arr_[size() - 1].~Value();
+            set_bits(type::Array, size() - 1);
         }
 
         void Value::insert_array_element(const Value &val, size_t index) noexcept
         {
-            assert(type_ == type::Array);
-            arr_.insert(arr_.begin() + index, val);
+            insert_array_element(Value(val, resource_), index);
+        }
+
+        void Value::insert_array_element(Value &&val, size_t index) noexcept
+        {
+            expand_if_lazy();
+            assert(tag() == type::Array && index <= size());
+            Value element(std::move(val), resource_);
+            size_t n = size();
+            reserve(n + 1);
+            new (&arr_[n]) Value(resource_);
+            for (size_t i = n; i > index; --i)
+                arr_[i].init(std::move(arr_[i - 1]));
+            arr_[index].init(std::move(element));
+            set_bits(type::Array, n + 1);
         }
 
         void Value::erase_array_element(size_t index, size_t count) noexcept
         {
-            assert(type_ == type::Array);
-            arr_.erase(arr_.begin() + index, arr_.begin() + index + count);
+            expand_if_lazy();
+            assert(tag() == type::Array && index + count <= size());
+            if (count == 0)
+                return;
+            size_t n = size();
+            for (size_t i = index; i < index + count; ++i)
+                arr_[i].reset(type::Null);
+            for (size_t i = index; i + count < n; ++i)
+                arr_[i].init(std::move(arr_[i + count]));
+            for (size_t i = n - count; i < n; ++i)
+                arr_[i].~Value();
+            set_bits(type::Array, n - count);
         }
 
         void Value::clear_array() noexcept
         {
-            assert(type_ == type::Array);
-            arr_.clear();
+            expand_if_lazy();
+            assert(tag() == type::Array);
+            for (size_t i = 0; i < size(); ++i)
+                arr_[i].~Value();
+            set_bits(type::Array, 0);
         }
 
         size_t Value::get_object_size() const noexcept
         {
-            assert(type_ == type::Object);
-            return obj_.size();
+            expand_if_lazy();
+            assert(tag() == type::Object);
+            return size();
         }
-        const std::string &Value::get_object_key(size_t index) const noexcept
+        std::string_view Value::get_object_key(size_t index) const noexcept
         {
-            assert(type_ == type::Object);
-            return obj_[index].first;
+            expand_if_lazy();
+            assert(tag() == type::Object);
+            return obj_[index].key.view();
         }
         size_t Value::get_object_key_length(size_t index) const noexcept
         {
-            assert(type_ == type::Object);
-            return obj_[index].first.size();
+            return get_object_key(index).size();
         }
         const Value &Value::get_object_value(size_t index) const noexcept
         {
-            assert(type_ == type::Object);
-            return obj_[index].second;
+            expand_if_lazy();
+            assert(tag() == type::Object);
+            return obj_[index].value;
         }
-        void Value::set_object_value(const std::string& key, const Value &val) noexcept
+        void Value::set_object_value(std::string_view key, const Value &val) noexcept
         {
-            assert(type_ == type::Object);
-            auto index = find_object_index(key);
-            if(index >= 0)
-                obj_[index].second = val;
-            else    
-                obj_.emplace_back(std::string(key), val);
+            set_object_value(key, Value(val, resource_));
         }
 
-        void Value::set_object(const std::vector<std::pair<std::string, Value>> &obj) noexcept
+        void Value::set_object_value(std::string_view key, Value &&val) noexcept
         {
-            if(type_ == type::Object) {
-                obj_ = obj;
+            expand_if_lazy();
+            assert(tag() == type::Object);
+            auto index = find_object_index(key);
+            if(index >= 0) {
+                obj_[index].value = std::move(val);
             } else {
-                free();
-                type_ = type::Object;
-                new(&obj_) std::vector<std::pair<std::string, Value>>(obj);
+                // key may point into this object or into val, which reserve and the move invalidate
+                Key copy(key, resource_);
+                Value value(std::move(val), resource_);
+                size_t n = size();
+                reserve(n + 1);
+                new (&obj_[n]) Member{copy, std::move(value)};
+                set_bits(type::Object, n + 1);
+                if(block()->index)
+                    block()->index->insert(obj_, n + 1, n);
+                else
+                    index_members();
             }
         }
-        
-        long long Value::find_object_index(const std::string &key) const noexcept
+
+        void Value::set_object(const Members &obj) noexcept
         {
-            assert(type_ == type::Object);
-            for(int i = 0; i < obj_.size(); ++i) {
-                if(obj_[i].first == key)
+            Value tmp(resource_);
+            tmp.set_bits(type::Object, 0);
+            tmp.obj_ = nullptr;
+            tmp.reserve(obj.size());
+            for (const auto &m : obj)
+                new (&tmp.obj_[tmp.size()]) Member{Key(m.first, resource_), Value(m.second, resource_)}, tmp.set_bits(type::Object, tmp.size() + 1);
+            tmp.index_members();
+            free();
+            init(std::move(tmp));
+        }
+
+        void Value::set_object(Members &&obj) noexcept
+        {
+            Value tmp(resource_);
+            tmp.set_bits(type::Object, 0);
+            tmp.obj_ = nullptr;
+            tmp.reserve(obj.size());
+            for (auto &m : obj)
+                new (&tmp.obj_[tmp.size()]) Member{Key(m.first, resource_), Value(std::move(m.second), resource_)}, tmp.set_bits(type::Object, tmp.size() + 1);
+            tmp.index_members();
+            free();
+            init(std::move(tmp));
+        }
+
+        void Value::set_object(const std::string_view *keys, Value *values, size_t count, bool shared_keys) noexcept
+        {
+            Member *members = count > 0 ? allocate_block<Member>(resource_, count) : nullptr;
+            for (size_t i = 0; i < count; ++i)
+                new (&members[i]) Member{shared_keys ? Key::shared(keys[i]) : Key(keys[i], resource_), Value(std::move(values[i]), resource_)};
+            free();
+            set_bits(type::Object, count);
+            obj_ = members;
+            index_members();
+        }
+
+        long long Value::find_object_index(std::string_view key) const noexcept
+        {
+            expand_if_lazy();
+            assert(tag() == type::Object);
+            size_t n = size();
+            if(n >= ObjectIndex::threshold)
+                return block()->index->find(obj_, key);
+            for(size_t i = 0; i < n; ++i) {
+                if(obj_[i].key.view() == key)
                     return i;
             }
             return -1;
@@ -210,42 +660,73 @@ namespace UT::json
 
         void Value::remove_object_value(size_t index) noexcept
         {
-            assert(type_ == type::Object);
-            obj_.erase(obj_.begin() + index, obj_.begin() + index + 1);
+            expand_if_lazy();
+            assert(tag() == type::Object && index < size());
+            drop_index();
+            size_t n = size();
+            obj_[index].key.free(resource_);
+            obj_[index].value.reset(type::Null);
+            for (size_t i = index; i + 1 < n; ++i)
+            {
+                obj_[i].key = obj_[i + 1].key;
+                obj_[i].value.init(std::move(obj_[i + 1].value));
+            }
+            obj_[n - 1].value.~Value();
+            set_bits(type::Object, n - 1);
+            index_members();
         }
 
         void Value::clear_object() noexcept
         {
-            assert(type_ == type::Object);
-            obj_.clear();
+            expand_if_lazy();
+            assert(tag() == type::Object);
+            drop_index();
+            for (size_t i = 0; i < size(); ++i)
+            {
+                obj_[i].key.free(resource_);
+                obj_[i].value.~Value();
+            }
+            set_bits(type::Object, 0);
         }
 
         bool operator==(const Value &rhs, const Value &lhs) noexcept
         {
-            if(lhs.type_ != rhs.type_)
+            lhs.expand_if_lazy();
+            rhs.expand_if_lazy();
+            if(lhs.tag() != rhs.tag())
                 return false;
-            switch (lhs.type_)
+            switch (lhs.tag())
             {
-                case type::Array: return lhs.arr_ == rhs.arr_;
-                case type::String: return lhs.str_ == rhs.str_;
+                case type::Array: {
+                    if(lhs.size() != rhs.size())
+                        return false;
+                    for(size_t i = 0; i < lhs.size(); ++i) {
+                        if(lhs.arr_[i] != rhs.arr_[i]) return false;
+                    }
+                    return true;
+                }
+                case type::String: return lhs.get_string() == rhs.get_string();
                 case type::Number: return lhs.num_ == rhs.num_;
-                case type::Object: 
-                    if(lhs.get_object_size() != rhs.get_object_size())
+                case type::Object: {
+                    const Member *l = lhs.obj_, *r = rhs.obj_;
+                    size_t n = lhs.size();
+                    if(n != rhs.size())
                         return false;
-                    for(size_t i = 0; i < lhs.get_object_size(); ++i) {
-                        auto index = rhs.find_object_index(lhs.get_object_key(i));
+                    size_t i = 0;
+                    for(; i < n && l[i].key == r[i].key; ++i) {
+                        if(l[i].value != r[i].value) return false;
+                    }
+                    for(; i < n; ++i) {
+                        auto index = rhs.find_object_index(l[i].key.view());
 
-                        if(index < 0 || lhs.get_object_value(i) != rhs.get_object_value(index)) return false;
+                        if(index < 0 || l[i].value != r[index].value) return false;
                     }
 
                     return true;
-                case type::Null:
-                case type::True:
-                case type::False:
+                }
+                default:
                     return true;
             }
-
-            return true;
         }
 
         bool operator!=(const Value &rhs, const Value &lhs) noexcept
@@ -1,23 +1,50 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <variant>
 #include <utility>
 
 #include "json.h"
+#include "jsonObjectIndex.h"
 
 namespace UT::json {
+        // Strings, arrays and members allocate from the node's memory_resource and follow
+        // std::pmr rules: copies made without an allocator use the default resource,
+        // assignment keeps the target's resource.
+        //
+        // A node is 24 bytes: the payload, the type and size packed into one word, and the
+        // resource. Strings of up to 8 bytes are kept inline; arrays and objects keep their
+        // elements in one block, behind a header with the capacity and the object index.
         class Value final {
             public:
-                Value() noexcept {num_ = 0;};
-                Value(const Value& rhs) noexcept {init(rhs);}
+                using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+                Value() noexcept : Value(allocator_type()) {}
+                explicit Value(const allocator_type& alloc) noexcept : num_(0), bits_(0), resource_(alloc.resource()) {}
+                Value(const Value& rhs) noexcept {init(rhs, allocator_type().resource());}
+                Value(const Value& rhs, const allocator_type& alloc) noexcept {init(rhs, alloc.resource());}
                 Value& operator=(const Value& rhs) noexcept;
+                Value(Value&& rhs) noexcept {init(std::move(rhs));}
+                Value(Value&& rhs, const allocator_type& alloc) noexcept;
+                Value& operator=(Value&& rhs) noexcept;
                 ~Value() noexcept;
 
             public:
-                void decode(const std::string& content);
+                void decode(std::string_view content);
+                // stores each distinct key once and never frees it on its own, so the resource
+                // must be released all at once, like the arena of Json::decode_arena
+                void decode_interned(std::string_view content);
+                // text must outlive the value and its copies' sources
+                void decode_lazy(const char* text, size_t size);
                 void stringify(std::string& content) const noexcept;
+                void stringify_append(std::string& content) const noexcept;
+                void stringify(const Sink& sink) const;
+
+                allocator_type get_allocator() const noexcept;
 
                 type get_type() const noexcept;
                 void set_type(type t) noexcept;
@@ -25,47 +52,136 @@ namespace UT::json {
                 double get_number() const noexcept;
                 void set_number(double d) noexcept;
 
-                const std::string& get_string() const noexcept;
-                void set_string(const std::string& str) noexcept;
+                std::string_view get_string() const noexcept;
+                void set_string(std::string_view str) noexcept;
 
                 size_t get_array_size() const noexcept;
                 const Value& get_array_element(size_t index) const noexcept;
-                void set_array(const std::vector<Value>&) noexcept;
+                void set_array(const std::pmr::vector<Value>&) noexcept;
+                void set_array(std::pmr::vector<Value>&&) noexcept;
+                // moves count values into a new array
+                void set_array(Value* values, size_t count) noexcept;
+                // the rvalue overloads move val unless it uses another resource
                 void push_back_array_element(const Value& val) noexcept;
+                void push_back_array_element(Value&& val) noexcept;
                 void pop_back_array_element() noexcept;
                 void insert_array_element(const Value& val, size_t index) noexcept;
+                void insert_array_element(Value&& val, size_t index) noexcept;
                 void erase_array_element(size_t index, size_t count) noexcept;
                 void clear_array() noexcept;
 
                 size_t get_object_size() const noexcept;
-                const std::string& get_object_key(size_t index) const noexcept;
+                std::string_view get_object_key(size_t index) const noexcept;
                 size_t get_object_key_length(size_t index) const noexcept;
 
                 const Value& get_object_value(size_t index) const noexcept;
-                void set_object_value(const std::string& key, const Value& val) noexcept;
-                void set_object(const std::vector<std::pair<std::string, Value>>& obj) noexcept;
-
-                long long find_object_index(const std::string& key) const noexcept;
+                void set_object_value(std::string_view key, const Value& val) noexcept;
+                void set_object_value(std::string_view key, Value&& val) noexcept;
+                void set_object(const Members& obj) noexcept;
+                void set_object(Members&& obj) noexcept;
+                // copies count keys and moves count values into a new object; shared keys
+                // are not copied and must outlive the object
+                void set_object(const std::string_view* keys, Value* values, size_t count, bool shared_keys = false) noexcept;
+
+                long long find_object_index(std::string_view key) const noexcept;
                 void remove_object_value(size_t index) noexcept;
 
                 void clear_object() noexcept;
 
             private:
-                void init(const Value& rhs) noexcept;
-                void free() noexcept;
+                // in front of the elements of an array or the members of an object
+                struct Block {
+                    size_t capacity;
+                    // objects with at least ObjectIndex::threshold members keep a hash index,
+                    // built when they reach that size, so lookups only read; members keep
+                    // insertion order
+                    ObjectIndex* index;
+                };
 
-                json::type type_ = json::type::Null;
+                // An array or object of a lazily decoded document that has not been accessed
+                // yet keeps the validated text of the value in lazy_ and its length as size.
+                // The first access through a const accessor builds one level, so concurrent
+                // readers must synchronize.
+                static constexpr type lazy_array = static_cast<type>(16);
+                static constexpr type lazy_object = static_cast<type>(17);
+                static constexpr size_t inline_size = 8;
+
+                type tag() const noexcept { return static_cast<type>(bits_ & 0xFF); }
+                size_t size() const noexcept { return bits_ >> 8; }
+                void set_bits(type t, size_t size) noexcept { bits_ = static_cast<uint64_t>(size) << 8 | static_cast<uint8_t>(t); }
+                Block* block() const noexcept;
+                void reserve(size_t capacity) noexcept;
+
+                void init(const Value& rhs, std::pmr::memory_resource* resource) noexcept;
+                void init(Value&& rhs) noexcept;
+                void free() noexcept;
+                void reset(type t) noexcept;
+                void index_members() noexcept;
+                void drop_index() noexcept;
+                void expand() const;
+                bool is_lazy() const noexcept { return tag() == lazy_array || tag() == lazy_object; }
+                void expand_if_lazy() const
+                {
+                    if (is_lazy())
+                        expand();
+                }
+                static Value lazy(const char* begin, const char* end, std::pmr::memory_resource* resource) noexcept;
 
                 union {
                     double num_;
-                    std::string str_;
-                    std::vector<Value> arr_;
-                    std::vector<std::pair<std::string, Value>> obj_;
+                    char small_[inline_size];
+                    char* str_;
+                    Value* arr_;
+                    Member* obj_;
+                    const char* lazy_;
                 };
+                // the type in the low byte; the length of a string, the number of elements or
+                // members, or the length of lazy text above it
+                uint64_t bits_;
+                std::pmr::memory_resource* resource_;
 
                 friend bool operator==(const Value& rhs, const Value& lhs) noexcept;
         };
 
+        // An object member's key: up to 8 bytes inline, longer keys allocated from the
+        // object's resource. The object owns the key and frees it; copies are shallow.
+        // A shared key points to text owned elsewhere, e.g. an interned key, and is not freed.
+        class Key final {
+            public:
+                static constexpr size_t inline_size = 8;
+
+                Key(std::string_view key, std::pmr::memory_resource* resource) noexcept;
+                static Key shared(std::string_view text) noexcept;
+                void free(std::pmr::memory_resource* resource) noexcept;
+                size_t size() const noexcept { return size_ & ~shared_bit; }
+                std::string_view view() const noexcept { return {size() <= sizeof(small_) ? small_ : data_, size()}; }
+
+                // interned keys of one document compare by address first
+                bool operator==(const Key& rhs) const noexcept
+                {
+                    if (size() > sizeof(small_) && data_ == rhs.data_ && size() == rhs.size())
+                        return true;
+                    return view() == rhs.view();
+                }
+                bool operator!=(const Key& rhs) const noexcept { return !(*this == rhs); }
+
+            private:
+                Key() noexcept = default;
+
+                static constexpr size_t shared_bit = size_t(1) << (sizeof(size_t) * 8 - 1);
+
+                union {
+                    char small_[inline_size];
+                    char* data_;
+                };
+                size_t size_;
+        };
+
+        struct Member {
+            Key key;
+            Value value;
+        };
+
         bool operator==(const Value& rhs, const Value& lhs) noexcept;
         bool operator!=(const Value& rhs, const Value& lhs) noexcept;
-    }
\ No newline at end of file
+    }
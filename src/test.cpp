@@ -1,5 +1,14 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
 #include <string.h>
+#include <thread>
+#include <vector>
 
 #include "json.h"
 
@@ -67,6 +76,53 @@ static void test_parse_number()
 	TEST_NUMBER(1.234E+10, "1.234E+10");
 	TEST_NUMBER(1.234E-10, "1.234E-10");
 	TEST_NUMBER(0.0, "1e-10000"); /* must underflow */
+	TEST_NUMBER(0.0, "-1e-10000");
+	TEST_NUMBER(0.0, "0.000000000000000000000000000000e99999");
+
+	TEST_NUMBER(1.0000000000000002, "1.0000000000000002"); /* the smallest number > 1 */
+	TEST_NUMBER(4.9406564584124654e-324, "4.9406564584124654e-324"); /* minimum denormal */
+	TEST_NUMBER(-4.9406564584124654e-324, "-4.9406564584124654e-324");
+	TEST_NUMBER(2.2250738585072009e-308, "2.2250738585072009e-308"); /* max subnormal double */
+	TEST_NUMBER(-2.2250738585072009e-308, "-2.2250738585072009e-308");
+	TEST_NUMBER(2.2250738585072014e-308, "2.2250738585072014e-308"); /* min normal positive double */
+	TEST_NUMBER(-2.2250738585072014e-308, "-2.2250738585072014e-308");
+	TEST_NUMBER(1.7976931348623157e+308, "1.7976931348623157e+308"); /* max double */
+	TEST_NUMBER(-1.7976931348623157e+308, "-1.7976931348623157e+308");
+
+	TEST_NUMBER(9007199254740992.0, "9007199254740992");
+	TEST_NUMBER(9007199254740992.0, "9007199254740993"); /* rounds to even */
+	TEST_NUMBER(9007199254740994.0, "9007199254740994");
+	TEST_NUMBER(1e22, "1e22");
+	TEST_NUMBER(1e23, "1e23");
+	TEST_NUMBER(0.1, "0.1");
+	TEST_NUMBER(123456789012345678901234567890.0, "123456789012345678901234567890");
+	TEST_NUMBER(1.0, "1.00000000000000000000000000000");
+	TEST_NUMBER(0.3, "0.299999999999999999999999999999");
+
+	// every result must match strtod bit for bit
+	unsigned seed = 12345;
+	int mismatches = 0;
+	for (int i = 0; i < 10000; ++i) {
+		char buf[64];
+		seed = seed * 1103515245 + 12345;
+		unsigned long long m = (static_cast<unsigned long long>(seed) << 20) ^ (seed >> 3);
+		switch (i % 4) {
+		case 0: snprintf(buf, sizeof(buf), "%llu", m % 100000000); break;
+		case 1: snprintf(buf, sizeof(buf), "-%llu.%03llu", m % 100000, m % 1000); break;
+		case 2: snprintf(buf, sizeof(buf), "%llue%d", m, int(seed % 640) - 330); break;
+		default: snprintf(buf, sizeof(buf), "%.17g", static_cast<double>(m) * 1e-7); break;
+		}
+        UT::Json j;
+		j.decode(buf, status);
+		double expect = strtod(buf, nullptr);
+		if (status != "parse ok") {
+			mismatches += expect != HUGE_VAL && expect != -HUGE_VAL;
+			continue;
+		}
+		double actual = j.get_number();
+		mismatches += memcmp(&expect, &actual, sizeof(double)) != 0;
+	}
+	EXPECT_EQ_BASE(0, mismatches);
 }
 
 #define TEST_STRING(expect, content)\
@@ -95,6 +151,10 @@ static void test_parse_string()
 	TEST_STRING("\xE2\x82\xAC", "\"\\u20AC\""); /* Euro sign U+20AC */
 	TEST_STRING("\xF0\x9D\x84\x9E", "\"\\uD834\\uDD1E\"");  /* G clef sign U+1D11E */
 	TEST_STRING("\xF0\x9D\x84\x9E", "\"\\ud834\\udd1e\"");  /* G clef sign U+1D11E */
+
+	/* escapes on both sides of the 16 and 32 byte scanning blocks */
+	TEST_STRING("0123456789abcde\n0123456789abcdef\t0123456789abcde\"", "\"0123456789abcde\\n0123456789abcdef\\t0123456789abcde\\\"\"");
+	TEST_STRING("\xE2\x82\xAC" "0123456789abcdef0123456789abcdef" "\xE2\x82\xAC", "\"\\u20AC0123456789abcdef0123456789abcdef\\u20AC\"");
 }
 
 static void test_parse_array()
@@ -247,6 +307,7 @@ static void test_parse_missing_quotation_mark()
 {
 	TEST_ERROR("parse miss quotation mark", "\"");
 	TEST_ERROR("parse miss quotation mark", "\"abc");
+	TEST_ERROR("parse miss quotation mark", "\"0123456789abcdef0123456789abcdef0123456789");
 }
 
 static void test_parse_invalid_string_escape()
@@ -264,6 +325,7 @@ static void test_parse_invalid_string_char()
 #if 1
 	TEST_ERROR("parse invalid string char", "\"\x01\"");
 	TEST_ERROR("parse invalid string char", "\"\x1F\"");
+	TEST_ERROR("parse invalid string char", "\"0123456789abcdef0123456789abcdef\x1F\"");
 #endif
 }
 
@@ -327,6 +389,67 @@ static void test_parse_miss_comma_or_curly_bracket()
 	TEST_ERROR("parse miss comma or curly bracket", "{\"a\":{}");
 }
 
+// the first length bytes of content, in a buffer of exactly that size so that reading
+// past the end is caught by the address sanitizer
+#define TEST_SLICE(expect, content, length)\
+	do {\
+		std::unique_ptr<char[]> buffer(new char[length]);\
+		memcpy(buffer.get(), std::string_view(content).data(), length);\
+		std::string_view slice(buffer.get(), length);\
+		for (json::parse_mode mode : {json::parse_mode::Default, json::parse_mode::Lazy}) {\
+			UT::Json v;\
+			try {\
+				v.decode(slice, mode);\
+				status = "parse ok";\
+			} catch (const std::exception& e) {\
+				status = e.what();\
+			}\
+			EXPECT_EQ_BASE(expect, status);\
+		}\
+	} while(0)
+
+static void test_parse_slice()
+{
+	TEST_SLICE("parse ok", "123456", 3);
+	TEST_SLICE("parse ok", "-0.5e10", 7);
+	TEST_SLICE("parse ok", "truex", 4);
+	TEST_SLICE("parse ok", "\"abc\"def", 5);
+	TEST_SLICE("parse ok", "[1, {\"a\": null}]]", 16);
+	TEST_SLICE("parse ok", " 1 \n", 4);
+	TEST_SLICE("parse expect value", " ", 1);
+	TEST_SLICE("parse expect value", "[1,", 3);
+	TEST_SLICE("parse invalid value", "null", 3);
+	TEST_SLICE("parse invalid value", "-5", 1);
+	TEST_SLICE("parse invalid value", "1.5", 2);
+	TEST_SLICE("parse invalid value", "1e5", 2);
+	TEST_SLICE("parse invalid value", "1e+5", 3);
+	TEST_SLICE("parse miss quotation mark", "\"abc\"", 3);
+	TEST_SLICE("parse miss quotation mark", "\"abcdefghijklmnopqrstuvwxyz0123456789\"", 37);
+	TEST_SLICE("parse miss quotation mark", "\"a\\n\"", 3);
+	TEST_SLICE("parse invalid unicode hex", "\"\\u1234\"", 5);
+	TEST_SLICE("parse invalid unicode surrogate", "\"\\uD800\\uDC00\"", 7);
+	TEST_SLICE("parse invalid unicode surrogate", "\"\\uD800\\uDC00\"", 8);
+	TEST_SLICE("parse invalid unicode hex", "\"\\uD800\\uDC00\"", 12);
+	TEST_SLICE("parse miss comma or square bracket", "[1]", 2);
+	TEST_SLICE("parse miss comma or square bracket", "[1 ]", 3);
+	TEST_SLICE("parse miss key", "{}", 1);
+	TEST_SLICE("parse miss colon", "{\"a\":1}", 4);
+	TEST_SLICE("parse expect value", "{\"a\":1}", 5);
+	TEST_SLICE("parse miss comma or curly bracket", "{\"a\":1}", 6);
+
+	// NUL is an ordinary byte now: invalid in a string or between values
+	TEST_SLICE("parse invalid string char", std::string("\"a\0b\"", 5), 5);
+	TEST_SLICE("parse root not singular", std::string("1\0", 2), 2);
+	TEST_SLICE("parse invalid value", std::string("\0", 1), 1);
+	TEST_SLICE("parse miss comma or square bracket", std::string("[1\0]", 4), 4);
+
+    UT::Json v;
+	v.decode("\"a\\u0000b\"");
+	EXPECT_EQ_BASE(std::string("a\0b", 3), v.get_string());
+	v.stringify(status);
+	EXPECT_EQ_BASE("\"a\\u0000b\"", status);
+}
+
 static void test_parse() {
 	test_parse_literal();
 	test_parse_number();
@@ -347,6 +470,7 @@ static void test_parse() {
 	test_parse_miss_key();
 	test_parse_miss_colon();
 	test_parse_miss_comma_or_curly_bracket();
+	test_parse_slice();
 }
 
 #define TEST_ROUNDTRIP(content)\
@@ -358,6 +482,15 @@ static void test_parse() {
 		EXPECT_EQ_BASE(content, status);\
 	} while(0)
 
+#define TEST_STRINGIFY(expect, content)\
+	do {\
+        UT::Json v;\
+		v.decode(content, status);\
+		EXPECT_EQ_BASE("parse ok", status);\
+		v.stringify(status);\
+		EXPECT_EQ_BASE(expect, status);\
+	} while(0)
+
 static void test_stringify_number() {
 	TEST_ROUNDTRIP("0");
 	TEST_ROUNDTRIP("-0");
@@ -371,14 +504,26 @@ static void test_stringify_number() {
 	TEST_ROUNDTRIP("1.234e-20");
 
 	TEST_ROUNDTRIP("1.0000000000000002"); /* the smallest number > 1 */
-	TEST_ROUNDTRIP("4.9406564584124654e-324"); /* minimum denormal */
-	TEST_ROUNDTRIP("-4.9406564584124654e-324");
-	TEST_ROUNDTRIP("2.2250738585072009e-308");  /* Max subnormal double */
-	TEST_ROUNDTRIP("-2.2250738585072009e-308");
+	TEST_ROUNDTRIP("5e-324"); /* minimum denormal */
+	TEST_ROUNDTRIP("-5e-324");
+	TEST_ROUNDTRIP("2.225073858507201e-308");  /* Max subnormal double */
+	TEST_ROUNDTRIP("-2.225073858507201e-308");
 	TEST_ROUNDTRIP("2.2250738585072014e-308");  /* Min normal positive double */
 	TEST_ROUNDTRIP("-2.2250738585072014e-308");
 	TEST_ROUNDTRIP("1.7976931348623157e+308");  /* Max double */
 	TEST_ROUNDTRIP("-1.7976931348623157e+308");
+
+	TEST_ROUNDTRIP("0.1");
+	TEST_ROUNDTRIP("100000");
+	TEST_ROUNDTRIP("-1700000000");
+	TEST_ROUNDTRIP("9007199254740992");
+	TEST_ROUNDTRIP("18014398509481984");
+	TEST_ROUNDTRIP("123456.789");
+	TEST_ROUNDTRIP("[0.3,1e-07,-2.5e+100]");
+	TEST_STRINGIFY("0.1", "0.10000000000000001");
+	TEST_STRINGIFY("5e-324", "4.9406564584124654e-324");
+	TEST_STRINGIFY("1000", "1e3");
+	TEST_STRINGIFY("-0", "-0.0");
 }
 
 static void test_stringify_string() {
@@ -387,6 +532,11 @@ static void test_stringify_string() {
 	TEST_ROUNDTRIP("\"Hello\\nWorld\"");
 	TEST_ROUNDTRIP("\"\\\" \\\\ / \\b \\f \\n \\r \\t\"");
 	TEST_ROUNDTRIP("\"Hello\\u0000World\"");
+	TEST_ROUNDTRIP("\"\\u0001\\u000B\\u001F\\u001A\"");
+	TEST_ROUNDTRIP("\"\xE2\x82\xAC \xF0\x9D\x84\x9E\x7F\"");
+	TEST_ROUNDTRIP("\"a string longer than one SIMD block\\twith escapes\\\" inside, and at the end\\n\"");
+	TEST_ROUNDTRIP("\"0123456789012345678901234567890123456789012345678901234567890123456789\\\\\"");
+	TEST_STRINGIFY("\"/\"", "\"\\/\"");
 }
 
 static void test_stringify_array() {
@@ -399,6 +549,55 @@ static void test_stringify_object() {
 	TEST_ROUNDTRIP("{\"n\":null,\"f\":false,\"t\":true,\"i\":123,\"s\":\"abc\",\"a\":[1,2,3],\"o\":{\"1\":1,\"2\":2,\"3\":3}}");
 }
 
+static void test_stringify_append() {
+    UT::Json a, b;
+	a.decode("{\"id\":-12,\"v\":[0.5,null,\"x\\n\"]}");
+	b.decode("[true,false,-0,100000]");
+	std::string out = "prefix ";
+	a.stringify_append(out);
+	out += '\n';
+	b.stringify_append(out);
+	EXPECT_EQ_BASE("prefix {\"id\":-12,\"v\":[0.5,null,\"x\\n\"]}\n[true,false,-0,100000]", out);
+
+	size_t capacity = out.capacity();
+	b.stringify(out);
+	EXPECT_EQ_BASE("[true,false,-0,100000]", out);
+	EXPECT_EQ_BASE(capacity, out.capacity());
+}
+
+static void test_stringify_sink() {
+	std::string content = "[";
+	for (int i = 0; i < 20000; ++i)
+		content += (i ? ",{\"id\":" : "{\"id\":") + std::to_string(i) + ",\"tags\":[\"a\\tb\",null]}";
+	content += "]";
+    UT::Json v;
+	v.decode(content);
+
+	std::string joined;
+	size_t chunks = 0, largest = 0;
+	v.stringify([&](std::string_view chunk) {
+		joined += chunk;
+		++chunks;
+		largest = std::max(largest, chunk.size());
+	});
+	EXPECT_EQ_BASE(content, joined);
+	EXPECT_EQ_BASE(1, int(chunks > 1));
+	EXPECT_EQ_BASE(1, int(largest < 65 * 1024));
+
+	std::ostringstream out;
+	v.stringify(out);
+	EXPECT_EQ_BASE(content, out.str());
+
+    UT::Json small;
+	small.decode("\"tiny\"");
+	chunks = 0;
+	small.stringify([&](std::string_view chunk) {
+		EXPECT_EQ_BASE("\"tiny\"", chunk);
+		++chunks;
+	});
+	EXPECT_EQ_BASE(1, chunks);
+}
+
 static void test_stringify() {
 	TEST_ROUNDTRIP("null");
 	TEST_ROUNDTRIP("false");
@@ -407,6 +606,8 @@ static void test_stringify() {
 	test_stringify_string();
 	test_stringify_array();
 	test_stringify_object();
+	test_stringify_append();
+	test_stringify_sink();
 }
 
 #define TEST_EQUAL(json1, json2, equality)\
@@ -443,6 +644,17 @@ static void test_equal() {
 	TEST_EQUAL("{\"a\":1,\"b\":2}", "{\"a\":1,\"b\":2,\"c\":3}", 0);
 	TEST_EQUAL("{\"a\":{\"b\":{\"c\":{}}}}", "{\"a\":{\"b\":{\"c\":{}}}}", 1);
 	TEST_EQUAL("{\"a\":{\"b\":{\"c\":{}}}}", "{\"a\":{\"b\":{\"c\":[]}}}", 0);
+	TEST_EQUAL("{\"a\":1,\"b\":2,\"c\":3}", "{\"a\":1,\"c\":3,\"b\":2}", 1);
+	TEST_EQUAL("{\"a\":1,\"b\":2,\"c\":3}", "{\"a\":1,\"c\":3,\"d\":2}", 0);
+
+	std::string forward, backward, changed;
+	for (int i = 0; i < 40; ++i) {
+		forward += (i ? ",\"" : "{\"") + std::to_string(i) + "\":" + std::to_string(i);
+		backward += (i ? ",\"" : "{\"") + std::to_string(39 - i) + "\":" + std::to_string(39 - i);
+		changed += (i ? ",\"" : "{\"") + std::to_string(39 - i) + "\":" + std::to_string(i == 39 ? 1 : 39 - i);
+	}
+	TEST_EQUAL(forward + "}", backward + "}", 1);
+	TEST_EQUAL(forward + "}", changed + "}", 0);
 }
 
 static void test_copy() {
@@ -459,6 +671,15 @@ static void test_move() {
 	v3 = std::move(v2);
 	EXPECT_EQ_BASE(json::type::Null, v2.get_type());
 	EXPECT_EQ_BASE(1, int(v3 == v1));
+
+	v2.set_number(2.5);
+	UT::Json v4(std::move(v2));
+	EXPECT_EQ_BASE(2.5, v4.get_number());
+	v2 = std::move(v3);
+	EXPECT_EQ_BASE(1, int(v2 == v1));
+	UT::swap(v2, v4);
+	EXPECT_EQ_BASE(2.5, v2.get_number());
+	EXPECT_EQ_BASE(1, int(v4 == v1));
 }
 
 static void test_swap() {
@@ -470,6 +691,99 @@ static void test_swap() {
 	EXPECT_EQ_BASE("Hello",  v2.get_string());
 }
 
+static void test_view() {
+    UT::Json v;
+	v.decode("{\"s\":\"abc\",\"a\":[1,2,3],\"o\":{\"x\":null,\"y\":[]}}", status);
+	EXPECT_EQ_BASE("parse ok", status);
+
+	UT::JsonView root = v.view();
+	EXPECT_EQ_BASE(json::type::Object, root.get_type());
+	EXPECT_EQ_BASE(3, root.get_object_size());
+	EXPECT_EQ_BASE("abc", root.get_object_value(0).get_string_view());
+	EXPECT_EQ_BASE(root.get_object_value(0).get_string_view().data(), v.view().get_object_value(0).get_string_view().data());
+	std::string copy = root.get_object_value(0).get_string();
+	EXPECT_EQ_BASE("abc", copy);
+
+	double sum = 0;
+	for (UT::JsonView e : root.get_object_value(root.find_object_index("a")))
+		sum += e.get_number();
+	EXPECT_EQ_BASE(6.0, sum);
+
+	std::string keys;
+	for (UT::JsonMember m : root.get_object_value(2).members())
+		keys += m.key;
+	EXPECT_EQ_STRING("xy", keys);
+	EXPECT_EQ_BASE(json::type::Array, root.get_object_value(2).get_object_value(1).get_type());
+	EXPECT_EQ_BASE(1, int(root.get_object_value(1) == v.get_object_value(1).view()));
+
+	UT::JsonView empty;
+	EXPECT_EQ_BASE(json::type::Null, empty.get_type());
+}
+
+static void test_arena() {
+	const char* content = "{\"n\":null,\"s\":\"a string long enough to allocate\",\"a\":[1,[2],{\"k\":\"v\"}]}";
+    UT::Json heap, arena;
+	heap.decode(content);
+	arena.decode_arena(content);
+	EXPECT_EQ_BASE(1, int(heap == arena));
+
+	UT::Json copy = arena.get_object_value(2);
+	EXPECT_EQ_BASE(3, copy.get_array_size());
+
+    UT::Json e;
+	e.set_string("another string long enough to allocate");
+	for (int i = 0; i < 20; ++i)
+		arena.set_object_value("key" + std::to_string(i), e);
+	EXPECT_EQ_BASE(23, arena.get_object_size());
+	EXPECT_EQ_BASE(22, arena.find_object_index("key19"));
+
+    UT::Json moved(std::move(arena));
+	EXPECT_EQ_BASE(json::type::Null, arena.get_type());
+	EXPECT_EQ_BASE(json::type::Object, moved.get_type());
+	UT::swap(moved, heap);
+	EXPECT_EQ_BASE(23, heap.get_object_size());
+
+	heap.decode("[\"decoding again keeps the arena\", 1, 2]", status);
+	EXPECT_EQ_BASE("parse ok", status);
+	EXPECT_EQ_BASE(3, heap.get_array_size());
+	heap.decode("[1,", status);
+	EXPECT_EQ_BASE("parse expect value", status);
+	heap = moved;
+	EXPECT_EQ_BASE(json::type::Object, heap.get_type());
+
+	std::pmr::monotonic_buffer_resource resource;
+	{
+        UT::Json v;
+		v.decode(content, &resource);
+		EXPECT_EQ_BASE(1, int(v == moved));
+		v.set_object_value("e", e);
+	}
+
+	const char* records = "[{\"identifier\":1,\"description\":\"first\"},{\"identifier\":2,\"description\":\"second\"}]";
+	UT::Json interned, copied;
+	interned.decode_arena(records, true);
+	copied.decode(records);
+	EXPECT_EQ_BASE(1, int(interned == copied));
+	EXPECT_EQ_BASE(interned.view().get_array_element(0).get_object_key(1).data(), interned.view().get_array_element(1).get_object_key(1).data());
+	EXPECT_EQ_BASE(1, interned.view().get_array_element(1).find_object_index("description"));
+
+	UT::Json first = interned.get_array_element(0);
+	first.remove_object_value(0);
+	first.set_object_value("another long key", e);
+	EXPECT_EQ_BASE(1, first.find_object_index("another long key"));
+
+	UT::Json record = interned.get_array_element(1);
+	interned.decode("[]");
+	EXPECT_EQ_BASE("description", record.get_object_key(1));
+	copied.push_back_array_element(std::move(record));
+	EXPECT_EQ_BASE(3, copied.get_array_size());
+
+	interned.decode_arena("{\"identifier\":1,\"description\":2}", true);
+	interned.remove_object_value(0);
+	interned.set_object_value("identifier", e);
+	EXPECT_EQ_BASE(1, interned.find_object_index("identifier"));
+}
+
 static void test_access_null()
 {
     UT::Json v;
@@ -557,6 +871,77 @@ static void test_access_array()
 	EXPECT_EQ_BASE(0, a.get_array_size());
 }
 
+static void test_access_erase()
+{
+	const char* content = "[\"a\",\"this is a long string\",[1,2,3],{\"k\":\"another long string\"}]";
+	UT::Json a;
+	std::string out;
+
+	a.decode(content);
+	a.erase_array_element(3, 1);
+	a.erase_array_element(1, 2);
+	a.stringify(out);
+	EXPECT_EQ_BASE("[\"a\"]", out);
+
+	a.decode(content);
+	a.erase_array_element(1, 2);
+	a.stringify(out);
+	EXPECT_EQ_BASE("[\"a\",{\"k\":\"another long string\"}]", out);
+
+	a.decode(content);
+	a.erase_array_element(0, 4);
+	EXPECT_EQ_BASE(0, a.get_array_size());
+
+	a.decode(content);
+	a.pop_back_array_element();
+	a.pop_back_array_element();
+	a.stringify(out);
+	EXPECT_EQ_BASE("[\"a\",\"this is a long string\"]", out);
+
+	UT::Json o;
+	o.decode("{\"a\":1,\"long key name\":\"this is a long string\",\"k\":[1,2,3]}");
+	o.remove_object_value(2);
+	o.stringify(out);
+	EXPECT_EQ_BASE("{\"a\":1,\"long key name\":\"this is a long string\"}", out);
+	o.remove_object_value(0);
+	o.stringify(out);
+	EXPECT_EQ_BASE("{\"long key name\":\"this is a long string\"}", out);
+	o.remove_object_value(0);
+	EXPECT_EQ_BASE(0, o.get_object_size());
+}
+
+// strings and keys of up to 8 bytes are stored in the node
+static void test_access_inline_boundary()
+{
+	const char* content = "{\"12345678\":\"abcdefgh\",\"123456789\":\"abcdefghi\",\"\":\"\"}";
+	UT::Json o, copy;
+	std::string out;
+	o.decode(content);
+	EXPECT_EQ_BASE("12345678", o.get_object_key(0));
+	EXPECT_EQ_BASE("123456789", o.get_object_key(1));
+	EXPECT_EQ_BASE("abcdefgh", o.get_object_value(0).get_string());
+	EXPECT_EQ_BASE("abcdefghi", o.get_object_value(1).get_string());
+	EXPECT_EQ_BASE(1, o.find_object_index("123456789"));
+	EXPECT_EQ_BASE(-1, o.find_object_index("12345678 "));
+
+	copy = o;
+	EXPECT_EQ_BASE(1, int(copy == o));
+	copy.stringify(out);
+	EXPECT_EQ_BASE(content, out);
+
+	UT::Json s;
+	s.set_string("abcdefgh");
+	s.set_string("abcdefghi");
+	EXPECT_EQ_BASE("abcdefghi", s.get_string());
+	s.set_string("abcdefgh");
+	EXPECT_EQ_BASE("abcdefgh", s.get_string());
+	copy.set_object_value("abcdefgh", s);
+	copy.set_object_value("abcdefghijk", s);
+	EXPECT_EQ_BASE(5, copy.get_object_size());
+	EXPECT_EQ_BASE(0, copy.find_object_index("12345678"));
+	EXPECT_EQ_BASE(4, copy.find_object_index("abcdefghijk"));
+}
+
 static void test_access_object()
 {
     UT::Json o, v;
@@ -614,6 +999,550 @@ static void test_access_object()
 
 }
 
+static void test_access_large_object()
+{
+    UT::Json o, v;
+	o.set_object();
+	for (int i = 0; i < 100; ++i) {
+		v.set_number(i);
+		o.set_object_value("key" + std::to_string(i), v);
+	}
+	EXPECT_EQ_BASE(100, o.get_object_size());
+	for (int i = 0; i < 100; ++i)
+		EXPECT_EQ_BASE(i, o.find_object_index("key" + std::to_string(i)));
+	EXPECT_EQ_BASE(-1, o.find_object_index("key100"));
+
+	v.set_string("Hello");
+	o.set_object_value("key42", v);
+	EXPECT_EQ_BASE(100, o.get_object_size());
+	EXPECT_EQ_STRING("Hello", o.get_object_value(42).get_string());
+
+	o.remove_object_value(0);
+	EXPECT_EQ_BASE(-1, o.find_object_index("key0"));
+	EXPECT_EQ_BASE(98, o.find_object_index("key99"));
+
+	for (int i = 100; i < 200; ++i) {
+		v.set_number(i);
+		o.set_object_value("key" + std::to_string(i), v);
+	}
+	for (int i = 1; i < 200; ++i)
+		EXPECT_EQ_BASE(i - 1, o.find_object_index("key" + std::to_string(i)));
+
+	UT::Json copy = o;
+	EXPECT_EQ_BASE(150, copy.find_object_index("key151"));
+	EXPECT_EQ_BASE(1, int(copy == o));
+
+	o.clear_object();
+	EXPECT_EQ_BASE(-1, o.find_object_index("key1"));
+
+	// the index exists once the object is built, so lookups on a shared const object only read
+	std::string content = "{";
+	for (int i = 0; i < 100; ++i)
+		content += (i ? ",\"key" : "\"key") + std::to_string(i) + "\":" + std::to_string(i);
+	content += "}";
+	o.decode(content);
+	const UT::Json& shared = o;
+	int found[2] = {0, 0};
+	std::thread readers[2];
+	for (int t = 0; t < 2; ++t)
+		readers[t] = std::thread([&shared, &found, t] {
+			for (int i = 0; i < 100; ++i)
+				found[t] += shared.find_object_index("key" + std::to_string(i)) == i;
+		});
+	for (std::thread& reader : readers)
+		reader.join();
+	EXPECT_EQ_BASE(100, found[0]);
+	EXPECT_EQ_BASE(100, found[1]);
+
+	for (int i = 99; i >= 10; --i)
+		o.remove_object_value(i);
+	EXPECT_EQ_BASE(9, o.find_object_index("key9"));
+	for (int i = 10; i < 20; ++i) {
+		v.set_number(i);
+		o.set_object_value("key" + std::to_string(i), v);
+	}
+	EXPECT_EQ_BASE(19, o.find_object_index("key19"));
+	EXPECT_EQ_BASE(-1, o.find_object_index("key20"));
+}
+
+static void test_push_chunks(const std::string& content, size_t chunk) {
+    UT::Json expect, actual;
+	expect.decode(content, status);
+	std::string status2 = "parse ok";
+	UT::JsonPushParser parser;
+	try {
+		for (size_t i = 0; i < content.size(); i += chunk)
+			parser.feed(std::string_view(content).substr(i, chunk));
+		parser.finish(actual);
+	} catch (const std::exception& e) {
+		status2 = e.what();
+	}
+	EXPECT_EQ_BASE(status, status2);
+	EXPECT_EQ_BASE(1, int(expect == actual));
+}
+
+#define TEST_PUSH(content)\
+	do {\
+		for (size_t chunk : {1, 2, 3, 7, 64, 4096})\
+			test_push_chunks(content, chunk);\
+	} while(0)
+
+static void test_push() {
+	TEST_PUSH("");
+	TEST_PUSH(" null ");
+	TEST_PUSH("true");
+	TEST_PUSH("-0.5e-3");
+	TEST_PUSH("0");
+	TEST_PUSH("[1, 2.5, -3e2, \"a\", [], {}, [[null]], {\"k\": false}]");
+	TEST_PUSH("{ \"a\" : [ 1, \"x\\u00e9\\uD834\\uDD1E\\\"\\\\\" ],\n  \"b\":{ \"c\" :\"}\" } }");
+	TEST_PUSH("[\"a string long enough to be split by the scanner in the middle of a block\"]");
+
+	TEST_PUSH("nul");
+	TEST_PUSH("nulx");
+	TEST_PUSH("[tru]");
+	TEST_PUSH("-");
+	TEST_PUSH("1.");
+	TEST_PUSH("1e+");
+	TEST_PUSH("01");
+	TEST_PUSH("[1x]");
+	TEST_PUSH("[1,");
+	TEST_PUSH("[1");
+	TEST_PUSH("[");
+	TEST_PUSH("{");
+	TEST_PUSH("{\"a\"");
+	TEST_PUSH("{\"a\":1");
+	TEST_PUSH("{\"a\":1,");
+	TEST_PUSH("{1:1}");
+	TEST_PUSH("{\"a\" 1}");
+	TEST_PUSH("{\"a\\x\":1}");
+	TEST_PUSH("[\"abc");
+	TEST_PUSH("[\"abc\\");
+	TEST_PUSH("\"\\u12\"");
+	TEST_PUSH("\"\\uD800\\\"\"");
+	TEST_PUSH("\"a\x01\"");
+	TEST_PUSH("[?]");
+	TEST_PUSH("1e309");
+	TEST_PUSH("null x");
+
+	std::string wide = "[";
+	for (int i = 0; i < 500; ++i)
+		wide += (i ? ",{\"id\":" : "{\"id\":") + std::to_string(i) + ",\"v\":[" + std::to_string(i * 0.25) + ",\"s\\n\"]}";
+	wide += "]";
+	TEST_PUSH(wide);
+
+	UT::JsonPushParser parser;
+	UT::Json v;
+	parser.feed("[1,");
+	try {
+		parser.feed("]");
+	} catch (const std::exception&) {
+	}
+	parser.feed("{\"again\"");
+	parser.feed(":true}");
+	parser.finish(v);
+	EXPECT_EQ_BASE(json::type::Object, v.get_type());
+	parser.feed("2");
+	parser.finish(v);
+	EXPECT_EQ_BASE(2.0, v.get_number());
+}
+
+struct RecordingHandler : UT::JsonHandler {
+	std::string events;
+
+	void on_null() override { events += "null "; }
+	void on_bool(bool b) override { events += b ? "true " : "false "; }
+	void on_number(double d) override { events += std::to_string(int(d)) + " "; }
+	void on_string(std::string_view s) override { events += "\"" + std::string(s) + "\" "; }
+	void on_start_array() override { events += "[ "; }
+	void on_end_array(size_t n) override { events += "]" + std::to_string(n) + " "; }
+	void on_start_object() override { events += "{ "; }
+	void on_key(std::string_view k) override { events += std::string(k) + ": "; }
+	void on_end_object(size_t n) override { events += "}" + std::to_string(n) + " "; }
+};
+
+#define TEST_SAX(expect, content)\
+	do {\
+		RecordingHandler handler;\
+		UT::decode(content, handler);\
+		EXPECT_EQ_BASE(expect, handler.events);\
+	} while(0)
+
+#define TEST_SAX_ERROR(error, content)\
+	do {\
+		RecordingHandler handler;\
+		std::string message;\
+		try {\
+			UT::decode(content, handler);\
+		} catch (const std::exception& e) {\
+			message = e.what();\
+		}\
+		EXPECT_EQ_BASE(error, message);\
+	} while(0)
+
+static void test_parser() {
+	const char* documents[] = {
+		"{\"id\":1,\"method\":\"update\",\"params\":{\"tags\":[\"a\",\"b\"],\"note\":\"a note long enough to allocate\"}}",
+		"[1,2,3]",
+		"[1,",
+		"\"a string long enough to allocate\"",
+		"{\"key number one\":{\"key number two\":[{},[],null]}}",
+		"{\"a\":1}}",
+	};
+	UT::JsonParser parser;
+	UT::Json result, arena, expect;
+	arena.decode_arena("[]");
+	for (int round = 0; round < 2; ++round) {
+		for (const char* content : documents) {
+			expect.decode(content, status);
+			bool ok = status == "parse ok";
+			for (json::parse_mode mode : {json::parse_mode::Default, json::parse_mode::Lazy}) {
+				for (UT::Json* target : {&result, &arena}) {
+					std::string error = "parse ok";
+					try {
+						parser.decode(content, *target, mode);
+					} catch (const std::exception& e) {
+						error = e.what();
+					}
+					EXPECT_EQ_BASE(status, error);
+					if (ok)
+						EXPECT_EQ_BASE(1, int(*target == expect));
+					else
+						EXPECT_EQ_BASE(json::type::Null, target->get_type());
+				}
+			}
+		}
+	}
+	parser.decode("{\"a\":1}", arena);
+	arena.set_object_value("key number three", expect);
+	EXPECT_EQ_BASE(2, arena.get_object_size());
+}
+
+static void test_sax() {
+	TEST_SAX("null ", "null");
+	TEST_SAX("\"a\\b\" ", " \"a\\\\b\" ");
+	TEST_SAX("[ ]0 ", "[ ]");
+	TEST_SAX("{ }0 ", "{}");
+	TEST_SAX("[ 1 true [ false ]1 { a: null b: \"x\" }2 ]4 ", "[1, true, [false], {\"a\":null, \"b\":\"x\"}]");
+	TEST_SAX("{ k: { n: [ ]0 }1 }1 ", "{\"k\":{\"n\":[]}}");
+
+	TEST_SAX_ERROR("parse expect value", "");
+	TEST_SAX_ERROR("parse root not singular", "[] x");
+	TEST_SAX_ERROR("parse miss comma or square bracket", "[1 2]");
+	TEST_SAX_ERROR("parse miss key", "{1:2}");
+	TEST_SAX_ERROR("parse miss colon", "{\"a\" 2}");
+	TEST_SAX_ERROR("parse number too big", "[1e309]");
+
+	struct StopAtKey : UT::JsonHandler {
+		void on_key(std::string_view k) override { if (k == "stop") throw std::runtime_error("found"); }
+	} stop;
+	std::string message;
+	try {
+		UT::decode("{\"a\":1,\"stop\":2,\"b\":[}", stop);
+	} catch (const std::runtime_error& e) {
+		message = e.what();
+	}
+	EXPECT_EQ_BASE("found", message);
+}
+
+#define TEST_LAZY(content)\
+	do {\
+        UT::Json v1, v2;\
+        std::string status2 = "parse ok", s1, s2;\
+		v1.decode(content, status);\
+		try {\
+			v2.decode(content, json::parse_mode::Lazy);\
+		} catch (const std::exception& e) {\
+			status2 = e.what();\
+		}\
+		EXPECT_EQ_BASE(status, status2);\
+		v1.stringify(s1);\
+		v2.stringify(s2);\
+		EXPECT_EQ_BASE(s1, s2);\
+	} while(0)
+
+static void test_lazy() {
+	TEST_LAZY("");
+	TEST_LAZY(" 1.5 ");
+	TEST_LAZY("\"s\"");
+	TEST_LAZY(" [ ] ");
+	TEST_LAZY("{}");
+	TEST_LAZY("[1, [2, [3, []]], {\"a\": {\"b\": [true, null]}}, \"x\\\"]\"]");
+	TEST_LAZY("{ \"k\\u0041\" : { \"n\" : -1e3 } , \"s\" : \"}{][\\\\\" , \"e\":[ ] }");
+	TEST_LAZY("[1, 2");
+	TEST_LAZY("{\"a\": [1, }");
+	TEST_LAZY("[] x");
+
+	const char* content = "{ \"id\": 7, \"user\": { \"name\": \"ann\", \"tags\": [ \"a\", [ 1, 2 ] ] },\n"
+		"  \"k\\\"ey\": { \"deep\": [ { \"x\": 1 } ] }, \"list\": [ {}, [], \"]\" ] }";
+    UT::Json eager, lazy;
+	eager.decode(content);
+	lazy.decode(content, json::parse_mode::Lazy);
+	EXPECT_EQ_BASE(json::type::Object, lazy.get_type());
+	EXPECT_EQ_BASE(4, lazy.get_object_size());
+	EXPECT_EQ_BASE("k\"ey", lazy.get_object_key(2));
+	EXPECT_EQ_BASE(1, int(lazy == eager));
+
+    UT::Json user = lazy.get_object_value(lazy.find_object_index("user"));
+	EXPECT_EQ_BASE(json::type::Object, user.get_type());
+	EXPECT_EQ_BASE("ann", user.get_object_value(0).get_string());
+
+	UT::JsonView view = lazy.view();
+	UT::JsonView tags = view.get_object_value(1).get_object_value(1);
+	EXPECT_EQ_BASE(2, tags.get_array_size());
+	EXPECT_EQ_BASE(2.0, tags.get_array_element(1).get_array_element(1).get_number());
+
+    UT::Json copy = lazy;
+	lazy.decode("[1]");
+	EXPECT_EQ_BASE(1, int(copy == eager));
+
+    UT::Json e;
+	e.set_number(3);
+	copy.decode(content, json::parse_mode::Lazy);
+	copy.set_object_value("added", e);
+	EXPECT_EQ_BASE(5, copy.get_object_size());
+	copy.remove_object_value(0);
+	EXPECT_EQ_BASE(4, copy.get_object_size());
+	copy.set_object_value("list", e);
+	EXPECT_EQ_BASE(3.0, copy.get_object_value(copy.find_object_index("list")).get_number());
+
+    UT::Json moved(std::move(copy));
+	std::string out;
+	moved.stringify(out);
+	EXPECT_EQ_BASE("{\"user\":{\"name\":\"ann\",\"tags\":[\"a\",[1,2]]},\"k\\\"ey\":{\"deep\":[{\"x\":1}]},\"list\":3,\"added\":3}", out);
+}
+
+static void write_file(const char* path, const std::string& content) {
+	FILE* f = fopen(path, "wb");
+	fwrite(content.data(), 1, content.size(), f);
+	fclose(f);
+}
+
+#define TEST_FILE(content)\
+	do {\
+		write_file(path, content);\
+		UT::Json expect, actual, lazy;\
+		expect.decode(content);\
+		actual.decode_file(path);\
+		lazy.decode_file(path, json::parse_mode::Lazy);\
+		remove(path);\
+		EXPECT_EQ_BASE(1, int(expect == actual));\
+		EXPECT_EQ_BASE(1, int(expect == lazy));\
+	} while(0)
+
+static void test_file() {
+	const char* path = "test_file.json";
+	TEST_FILE("{\"a\": [1, 2, {\"b\": \"c\"}], \"d\": null}");
+	TEST_FILE("\"x\"");
+	// a page-sized mapping has nothing after its last byte
+	TEST_FILE("[1," + std::string(4096 - 6, ' ') + "2]");
+	TEST_FILE("[1," + std::string(8192 - 6, ' ') + "2]");
+
+	write_file(path, "[1, 2");
+	UT::Json j;
+	try {
+		j.decode_file(path);
+		status = "parse ok";
+	} catch (const std::exception& e) {
+		status = e.what();
+	}
+	EXPECT_EQ_BASE("parse miss comma or square bracket", status);
+
+	write_file(path, "{\"id\": 7, \"user\": {\"name\": \"ann\"}}");
+	j.decode_file(path, json::parse_mode::Lazy);
+	remove(path);
+	UT::Json moved(std::move(j));
+	UT::Json user = moved.get_object_value(moved.find_object_index("user"));
+	EXPECT_EQ_BASE("ann", user.get_object_value(0).get_string());
+
+	try {
+		j.decode_file(path);
+		status = "parse ok";
+	} catch (const std::exception& e) {
+		status = e.what();
+	}
+	EXPECT_EQ_BASE("file cannot open", status);
+}
+
+#define TEST_LINES(expect, content)\
+	do {\
+		std::string result;\
+		size_t docs = 0;\
+		size_t count = UT::decode_lines(content, [&](UT::Json& doc) {\
+			std::string out;\
+			++docs;\
+			doc.stringify(out);\
+			result += out + ";";\
+		}, [&](size_t offset, const std::string& error) {\
+			result += std::to_string(offset) + ": " + error + ";";\
+		});\
+		EXPECT_EQ_BASE(expect, result);\
+		EXPECT_EQ_BASE(docs, count);\
+	} while(0)
+
+static void test_lines() {
+	TEST_LINES("", "");
+	TEST_LINES("", " \n\r\n ");
+	TEST_LINES("1;", "1");
+	TEST_LINES("{\"a\":1};[2];\"x\";", "{\"a\": 1}\n[2]\n\"x\"\n");
+	TEST_LINES("{\"a\":1};[2];null;", "{\"a\":1}[2] null");
+	TEST_LINES("{\"a\":[1,2]};", "{\"a\":\n  [1,\n   2]}\n");
+	TEST_LINES("1;2: parse invalid value;3;", "1\n[1, x]\n3");
+	TEST_LINES("1;2: parse miss comma or square bracket;", "1\n[1, 2");
+	TEST_LINES("0: parse invalid value;[];", "tru\n[]");
+	TEST_LINES("true;5: parse invalid value;", "true x\n");
+
+	std::vector<UT::Json> kept;
+	size_t count = UT::decode_lines("[1]\n{\"b\": 2}\n3", [&](UT::Json& doc) {
+		kept.push_back(std::move(doc));
+	}, [](size_t, const std::string&) {});
+	EXPECT_EQ_BASE(3, count);
+	EXPECT_EQ_BASE(3, kept.size());
+	EXPECT_EQ_BASE(json::type::Array, kept[0].get_type());
+	EXPECT_EQ_BASE(2.0, kept[1].get_object_value(0).get_number());
+	EXPECT_EQ_BASE(3.0, kept[2].get_number());
+}
+
+static void test_lines_parallel() {
+	// over a few chunks, with some lines that fail
+	std::string content;
+	for (int i = 0; i < 60000; ++i)
+		content += i % 1000 == 7 ? "{\"id\": }\n" : "{\"id\": " + std::to_string(i) + ", \"tags\": [\"a\", \"b\"]}\n";
+
+	std::string expect, actual;
+	auto on_error = [](std::string& out) {
+		return [&out](size_t offset, const std::string& error) { out += std::to_string(offset) + error + ";"; };
+	};
+	size_t count = UT::decode_lines(content, [&](UT::Json& doc) {
+		expect += std::to_string(doc.get_object_value(0).get_number()) + ";";
+	}, on_error(expect));
+	EXPECT_EQ_BASE(60000 - 60, count);
+
+	for (unsigned threads : {2, 3, 8}) {
+		actual.clear();
+		count = UT::decode_lines(content, [&](UT::Json& doc) {
+			actual += std::to_string(doc.get_object_value(0).get_number()) + ";";
+		}, on_error(actual), threads);
+		EXPECT_EQ_BASE(60000 - 60, count);
+		EXPECT_EQ_BASE(expect, actual);
+	}
+
+	std::mutex mutex;
+	double sum = 0;
+	size_t errors = 0;
+	count = UT::decode_lines(content, [&](UT::Json& doc) {
+		std::lock_guard<std::mutex> lock(mutex);
+		sum += doc.get_object_value(0).get_number();
+	}, [&](size_t, const std::string&) {
+		std::lock_guard<std::mutex> lock(mutex);
+		++errors;
+	}, 4, false);
+	EXPECT_EQ_BASE(60000 - 60, count);
+	EXPECT_EQ_BASE(60, errors);
+	EXPECT_EQ_BASE(60000.0 * 59999 / 2 - (7 * 60 + 1000.0 * 59 * 60 / 2), sum);
+
+	try {
+		UT::decode_lines(content, [&](UT::Json&) { throw std::runtime_error("stop"); },
+			[](size_t, const std::string&) {}, 4);
+		status = "no exception";
+	} catch (const std::exception& e) {
+		status = e.what();
+	}
+	EXPECT_EQ_BASE("stop", status);
+}
+
+#define TEST_PARALLEL(content)\
+	do {\
+		UT::Json expect, actual;\
+		std::string expect_status, actual_status;\
+		try {\
+			expect.decode(content);\
+			expect_status = "parse ok";\
+		} catch (const std::exception& e) {\
+			expect_status = e.what();\
+		}\
+		for (unsigned threads : {1, 2, 3, 8}) {\
+			try {\
+				actual.decode_parallel(content, threads);\
+				actual_status = "parse ok";\
+			} catch (const std::exception& e) {\
+				actual_status = e.what();\
+			}\
+			EXPECT_EQ_BASE(expect_status, actual_status);\
+			EXPECT_EQ_BASE(1, int(expect == actual));\
+		}\
+	} while(0)
+
+static void test_parallel() {
+	std::string records;
+	for (int i = 0; i < 2000; ++i)
+		records += (i ? ", " : "") + std::string("{\"id\": ") + std::to_string(i) + ", \"s\": \"a,]\\\"[,{\", \"l\": [[1, 2], {}]}";
+	TEST_PARALLEL("[" + records + "]");
+	TEST_PARALLEL(" \n[ " + records + " ]\n ");
+	TEST_PARALLEL("[1, 2, 3]");
+	TEST_PARALLEL("[]");
+	TEST_PARALLEL("[[]]");
+	TEST_PARALLEL("{\"a\": [" + records + "]}");
+	TEST_PARALLEL("\"[1, 2]\"");
+	TEST_PARALLEL("[" + records + ", ]");
+	TEST_PARALLEL("[" + records + ",, 1]");
+	TEST_PARALLEL("[" + records + " 1]");
+	TEST_PARALLEL("[" + records + "] x");
+	TEST_PARALLEL("x [" + records + "]");
+	TEST_PARALLEL("[" + records);
+	TEST_PARALLEL("[" + records + "}");
+	TEST_PARALLEL("[" + records + "]]");
+	TEST_PARALLEL("[" + records.substr(0, records.size() / 2) + "\"" + records.substr(records.size() / 2) + "]");
+	TEST_PARALLEL("[" + records.substr(0, records.size() / 2) + "tru, " + records.substr(records.size() / 2) + "]");
+
+    UT::Json arena;
+	arena.decode_arena("[1]");
+	arena.decode_parallel("[" + records + "]", 4);
+	EXPECT_EQ_BASE(2000, arena.get_array_size());
+}
+
+static void test_access_move()
+{
+    UT::Json response, items, item, name;
+	response.set_object();
+	items.set_array();
+	for (int i = 0; i < 3; ++i) {
+		item.set_object();
+		name.set_string("a name long enough to allocate");
+		item.set_object_value("name", std::move(name));
+		EXPECT_EQ_BASE(json::type::Null, name.get_type());
+		items.push_back_array_element(std::move(item));
+		EXPECT_EQ_BASE(json::type::Null, item.get_type());
+	}
+	item.set_number(0);
+	items.insert_array_element(std::move(item), 0);
+	response.set_object_value(std::string("items"), std::move(items));
+	EXPECT_EQ_BASE(json::type::Null, items.get_type());
+
+	std::string content;
+	response.stringify(content);
+	EXPECT_EQ_BASE("{\"items\":[0,{\"name\":\"a name long enough to allocate\"},"
+		"{\"name\":\"a name long enough to allocate\"},{\"name\":\"a name long enough to allocate\"}]}", content);
+
+	// the key may point into the object itself
+	UT::Json o;
+	o.decode("{\"a\":\"k1\",\"b\":\"a key long enough to allocate\",\"c\":3,\"d\":4}");
+	UT::Json v;
+	v.set_number(5);
+	o.set_object_value(o.view().get_object_value(0).get_string_view(), v);
+	o.set_object_value(o.view().get_object_value(1).get_string_view(), std::move(v));
+	EXPECT_EQ_BASE(6, o.get_object_size());
+	EXPECT_EQ_BASE("k1", o.get_object_key(4));
+	EXPECT_EQ_BASE("a key long enough to allocate", o.get_object_key(5));
+	EXPECT_EQ_BASE(5.0, o.get_object_value(5).get_number());
+
+	// a tree in an arena is copied out and left as it was
+	UT::Json arena;
+	arena.decode_arena("[\"in the arena\"]");
+	response.set_object_value("items", std::move(arena));
+	EXPECT_EQ_BASE(1, arena.get_array_size());
+	EXPECT_EQ_BASE(1, int(response.get_object_value(0) == arena));
+}
+
 static void test_access()
 {
 	test_access_null();
@@ -621,7 +1550,11 @@ static void test_access()
 	test_access_number();
 	test_access_string();
 	test_access_array();
+	test_access_erase();
+	test_access_inline_boundary();
 	test_access_object();
+	test_access_large_object();
+	test_access_move();
 }
 
 int main() {
@@ -631,6 +1564,16 @@ int main() {
 	test_copy();
 	test_move();
 	test_swap();
+	test_view();
+	test_arena();
+	test_push();
+	test_parser();
+	test_sax();
+	test_lazy();
+	test_file();
+	test_lines();
+	test_lines_parallel();
+	test_parallel();
 	test_access();
 	printf("%d/%d (%3.2f%%) passed\n", test_pass, test_count, test_pass * 100.0 / test_count);
 	return main_ret;
@@ -1,8 +1,21 @@
 add_rules("mode.debug", "mode.release")
+set_languages("c++17")
 
 target("Json")
     set_kind("binary")
     add_files("src/*.cpp")
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+
+-- the bench counts allocations and RSS with glibc and POSIX calls
+if is_plat("linux") then
+    target("bench")
+        set_kind("binary")
+        add_includedirs("src")
+        add_files("src/*.cpp|test.cpp", "bench/*.cpp")
+        add_syslinks("pthread")
+end
 --
 -- If you want to known more usage about xmake, please see https://xmake.io
 --